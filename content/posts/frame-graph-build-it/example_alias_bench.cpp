@@ -0,0 +1,98 @@
+// Frame Graph -- aliasing at scale: greedy scan vs bitset first-fit
+// Compile: g++ -std=c++17 -O2 -o example_alias_bench example_alias_bench.cpp frame_graph_v3.cpp frame_graph_bitset.cpp
+#include "frame_graph_bitset.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// kPasses passes in a chain, each writing kOutputs fresh transients and
+// reading a few older ones from up to kWindow passes back — a wide spread
+// of lifetimes and sizes, mixing textures and buffers.
+static constexpr uint32_t kPasses  = 2500;
+static constexpr uint32_t kOutputs = 4;
+static constexpr uint32_t kWindow  = 1000;
+
+static void BuildFrame(FrameGraph& fg, std::vector<ResourceHandle>& res) {
+    fg.SetVerbose(false);
+    std::mt19937 rng(1234);
+    const uint32_t dims[]    = { 256, 512, 960, 1080, 1920, 2048 };
+    const Format   formats[] = { Format::R8, Format::RGBA8, Format::RGBA16F, Format::D32F };
+
+    for (uint32_t i = 0; i < kPasses * kOutputs; i++) {
+        if (rng() % 4 == 0) {
+            res.push_back(fg.CreateResource(BufferDesc((rng() % 4096 + 1) * 1024, 16)));
+        } else {
+            res.push_back(fg.CreateResource({ dims[rng() % 6], dims[rng() % 6],
+                                              formats[rng() % 4] }));
+        }
+    }
+    auto backbuffer = fg.ImportResource({1920, 1080, Format::RGBA8},
+                                        ResourceState::Present);
+
+    for (uint32_t p = 0; p < kPasses; p++) {
+        uint32_t extra[3];
+        for (auto& e : extra) {
+            uint32_t back = 1 + rng() % kWindow;
+            e = p >= back ? (p - back) * kOutputs + rng() % kOutputs : UINT32_MAX;
+        }
+        fg.AddPass("Pass" + std::to_string(p),
+            [&, p, extra]() {
+                if (p > 0) fg.Read(p, res[(p - 1) * kOutputs]);   // keeps the chain alive
+                for (uint32_t e : extra)
+                    if (e != UINT32_MAX) fg.Read(p, res[e]);
+                for (uint32_t o = 0; o < kOutputs; o++)
+                    fg.Write(p, res[p * kOutputs + o]);
+                if (p + 1 == kPasses) fg.Write(p, backbuffer);
+            },
+            [](/*cmd*/) {});
+    }
+}
+
+static double CompileMs(FrameGraph& fg, FreeBlockSearch* search,
+                        FrameGraph::CompiledPlan& plan) {
+    CompileOptions options;
+    options.blockSearch = search;
+    auto t0 = Clock::now();
+    plan = fg.Compile(options);
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+static uint64_t TotalBytes(const FrameGraph::CompiledPlan& plan) {
+    uint64_t total = 0;
+    for (auto& blk : plan.blocks) total += blk.sizeBytes;
+    return total;
+}
+
+int main() {
+    printf("=== Frame Graph: aliasing %u resources ===\n", kPasses * kOutputs);
+
+    for (HeapTier tier : { HeapTier::Tier2, HeapTier::Tier1 }) {
+        FrameGraph fg;
+        std::vector<ResourceHandle> res;
+        BuildFrame(fg, res);
+        fg.SetHeapTier(tier);
+
+        BitsetBlockSearch search;
+        FrameGraph::CompiledPlan greedy, bitset;
+        double greedyMs = 1e30, bitsetMs = 1e30;
+        for (int run = 0; run < 3; run++) {   // best of 3, Compile is re-entrant
+            greedyMs = std::min(greedyMs, CompileMs(fg, nullptr, greedy));
+            bitsetMs = std::min(bitsetMs, CompileMs(fg, &search, bitset));
+        }
+
+        bool identical = greedy.mapping == bitset.mapping
+                      && greedy.blocks.size() == bitset.blocks.size();
+        printf("\n  Heap %s:\n", tier == HeapTier::Tier2 ? "Tier2" : "Tier1");
+        printf("    greedy scan:  %8.2f ms compile, %5zu blocks, %8.1f MB\n",
+               greedyMs, greedy.blocks.size(), TotalBytes(greedy) / (1024.0 * 1024.0));
+        printf("    bitset:       %8.2f ms compile, %5zu blocks, %8.1f MB\n",
+               bitsetMs, bitset.blocks.size(), TotalBytes(bitset) / (1024.0 * 1024.0));
+        printf("    mappings %s, %.1fx faster\n",
+               identical ? "IDENTICAL" : "DIFFER", greedyMs / bitsetMs);
+        if (!identical) return 1;
+    }
+    return 0;
+}
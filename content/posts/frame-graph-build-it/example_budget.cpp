@@ -0,0 +1,88 @@
+// Frame Graph -- memory-budgeted compile
+// Compile: g++ -std=c++17 -o example_budget example_budget.cpp frame_graph_v3.cpp frame_graph_budget.cpp frame_graph_pool.cpp
+#include "frame_graph_budget.h"
+#include "frame_graph_pool.h"
+#include <cstdio>
+
+// Four shadow cascades, each rendered at 2048^2 and filtered down to a
+// small ESM map. Kahn's FIFO order renders all four cascades before
+// filtering any, so all four full-size depth maps are live together.
+static void BuildFrame(FrameGraph& fg) {
+    fg.SetVerbose(false);
+    auto backbuffer = fg.ImportResource({1920, 1080, Format::RGBA8},
+                                        ResourceState::Present);
+    auto hdr = fg.CreateResource({1920, 1080, Format::RGBA16F});
+
+    ResourceHandle depth[4], esm[4];
+    for (int c = 0; c < 4; c++) {
+        depth[c] = fg.CreateResource({2048, 2048, Format::D32F});
+        esm[c]   = fg.CreateResource({512,  512,  Format::RGBA16F});
+    }
+
+    uint32_t pass = 0;
+    for (int c = 0; c < 4; c++) {
+        uint32_t p = pass++;
+        fg.AddPass("Cascade" + std::to_string(c),
+            [&, p, c]() { fg.Write(p, depth[c]); }, [](){});
+    }
+    for (int c = 0; c < 4; c++) {
+        uint32_t p = pass++;
+        fg.AddPass("FilterESM" + std::to_string(c),
+            [&, p, c]() { fg.Read(p, depth[c]); fg.Write(p, esm[c]); }, [](){});
+    }
+    uint32_t lighting = pass++;
+    fg.AddPass("Lighting",
+        [&, lighting]() {
+            for (auto h : esm) fg.Read(lighting, h);
+            fg.Write(lighting, hdr);
+        }, [](){});
+    uint32_t present = pass++;
+    fg.AddPass("Present",
+        [&, present]() { fg.Read(present, hdr); fg.Write(present, backbuffer); },
+        [](){});
+}
+
+static void Report(const char* label, const FrameGraph::CompiledPlan& plan,
+                   const FrameGraph& fg) {
+    printf("\n  %s: %.1f MB%s\n", label, plan.memoryBytes / (1024.0 * 1024.0),
+           plan.overBudget ? "  (OVER BUDGET)" : "");
+    printf("    order: ");
+    for (size_t i = 0; i < plan.sorted.size(); i++)
+        printf("%s%s", fg.Passes()[plan.sorted[i]].name.c_str(),
+               i + 1 < plan.sorted.size() ? " -> " : "\n");
+}
+
+int main() {
+    printf("=== Frame Graph: memory-budgeted compile ===\n");
+
+    FrameGraph fg;
+    BuildFrame(fg);
+
+    auto unlimited = fg.Compile();
+    Report("No budget", unlimited, fg);
+
+    auto fitted = fg.CompileWithinBudget(48ull * 1024 * 1024);
+    Report("48 MB budget", fitted, fg);
+
+    // One 16 MB cascade plus four 2 MB ESM maps can never fit in 20 MB.
+    const uint64_t tooSmall = 20ull * 1024 * 1024;
+    auto failed = fg.CompileWithinBudget(tooSmall);
+    Report("20 MB budget", failed, fg);
+    printf("%s\n", failed.diagnostic.c_str());
+
+    fg.Execute(fitted);
+
+    // A plan that misses its budget is never committed: a fresh graph
+    // whose only compile fails keeps an empty heap pool.
+    FrameGraph strict;
+    HeapPool   pool;
+    strict.AddHook(&pool);
+    BuildFrame(strict);
+    auto rejected = strict.CompileWithinBudget(tooSmall);
+    bool untouched = rejected.overBudget && pool.Stats().allocations == 0
+                  && pool.Stats().residentBytes == 0;
+    printf("\n  Over-budget plan left the heap pool empty: %s\n", untouched ? "yes" : "NO");
+
+    return fitted.overBudget || !failed.overBudget || failed.diagnostic.empty()
+        || !untouched ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+// Frame Graph -- capture a few frames, save, reload and replay them
+// Compile: g++ -std=c++17 -O2 -o example_capture example_capture.cpp frame_graph_v3.cpp frame_graph_sim.cpp frame_graph_capture.cpp frame_graph_subgraph.cpp frame_graph_budget.cpp frame_graph_bitset.cpp
+#include "frame_graph_bitset.h"
+#include "frame_graph_budget.h"
+#include "frame_graph_capture.h"
+#include "frame_graph_sim.h"
+#include "frame_graph_subgraph.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static void Spin(int micros) {
+    auto until = Clock::now() + std::chrono::microseconds(micros);
+    while (Clock::now() < until) {}
+}
+
+// A two-pass shadow chain, instanced per cascade in the last frame.
+struct ShadowTemplate {
+    SubgraphTemplate tmpl{"Shadow"};
+    SubgraphSlot depth, out;
+
+    ShadowTemplate() {
+        depth = tmpl.Transient({1024, 1024, Format::D32F});
+        out   = tmpl.External();
+        tmpl.AddPass("Depth",  [&]() { tmpl.Write(0, depth); },
+                     [](const SubgraphView&) { Spin(30); });
+        tmpl.AddPass("Filter", [&]() { tmpl.Read(1, depth); tmpl.Write(1, out); },
+                     [](const SubgraphView&) { Spin(20); });
+        tmpl.Compile();
+    }
+};
+static constexpr uint32_t kCascades = 3;
+
+// example_v3's pipeline with `extraLights` light-culling passes bolted on,
+// so consecutive frames differ, and pass bodies that take real time.
+static void BuildFrame(FrameGraph& fg, uint32_t extraLights,
+                       const ShadowTemplate* shadow = nullptr) {
+    auto backbuffer = fg.ImportResource({1920, 1080, Format::RGBA8},
+                                        ResourceState::Present);
+    auto depth  = fg.CreateResource({1920, 1080, Format::D32F});
+    auto gbufA  = fg.CreateResource({1920, 1080, Format::RGBA8});
+    auto gbufN  = fg.CreateResource({1920, 1080, Format::RGBA8});
+    auto hdr    = fg.CreateResource({1920, 1080, Format::RGBA16F});
+    auto bloom  = fg.CreateResource({960,  540,  Format::RGBA16F});
+    auto debug  = fg.CreateResource({1920, 1080, Format::RGBA8});
+    std::vector<ResourceHandle> lights;
+    for (uint32_t i = 0; i <= extraLights; i++)
+        lights.push_back(fg.CreateResource(BufferDesc(4096 * 64, 64)));
+    std::vector<ResourceHandle> shadowMaps;
+    for (uint32_t c = 0; shadow && c < kCascades; c++) {
+        shadowMaps.push_back(fg.CreateResource({1024, 1024, Format::RGBA16F}));
+        fg.Instantiate(shadow->tmpl, SubgraphBindings(c).Bind(shadow->out, shadowMaps.back()));
+    }
+
+    uint32_t p = static_cast<uint32_t>(fg.Passes().size());
+    fg.AddPass("DepthPrepass", [&]() { fg.Write(p, depth); }, []() { Spin(40); });
+    p++;
+    fg.AddPass("GBuffer",
+        [&]() { fg.Read(p, depth); fg.Write(p, gbufA); fg.Write(p, gbufN); },
+        []() { Spin(120); });
+    for (uint32_t i = 0; i < lights.size(); i++) {
+        p++;
+        fg.AddPass("LightCulling" + std::to_string(i),
+            [&]() { fg.Read(p, depth); fg.Write(p, lights[i]); }, []() { Spin(20); });
+    }
+    p++;
+    fg.AddPass("Lighting",
+        [&]() { fg.Read(p, gbufA); fg.Read(p, gbufN);
+                for (auto h : lights) fg.Read(p, h);
+                for (auto h : shadowMaps) fg.Read(p, h);
+                fg.Write(p, hdr); },
+        []() { Spin(150); });
+    p++;
+    fg.AddPass("Bloom",   [&]() { fg.Read(p, hdr); fg.Write(p, bloom); }, []() { Spin(60); });
+    p++;
+    fg.AddPass("Tonemap", [&]() { fg.Read(p, bloom); fg.Write(p, hdr); }, []() { Spin(30); });
+    p++;
+    fg.AddPass("Present", [&]() { fg.Read(p, hdr); fg.Write(p, backbuffer); }, []() { Spin(10); });
+    p++;
+    fg.AddPass("DebugOverlay", [&]() { fg.Write(p, debug); }, []() { Spin(10); });
+}
+
+// Each frame compiles differently, so replay has to restore the
+// settings, not just the graph, to reproduce the plan.
+struct FrameSettings {
+    HeapTier tier;
+    bool     indexedSearch;
+    uint64_t budget;   // 0: Compile()
+    float    resolutionScale;
+};
+static const FrameSettings kSettings[] = {
+    { HeapTier::Tier2, false, 0,                   1.0f  },
+    { HeapTier::Tier1, false, 0,                   1.0f  },
+    { HeapTier::Tier2, true,  40ull * 1024 * 1024, 0.75f },
+    { HeapTier::Tier1, true,  0,                   0.5f  },
+};
+
+static FrameGraph::CompiledPlan CompileWith(FrameGraph& fg, bool indexedSearch, uint64_t budget,
+                                            BitsetBlockSearch& search) {
+    CompileOptions options;
+    if (indexedSearch) options.blockSearch = &search;
+    return budget ? fg.CompileWithinBudget(budget, options) : fg.Compile(options);
+}
+
+struct Snapshot {
+    std::vector<uint32_t> sorted, mapping;
+    uint64_t memoryBytes = 0;
+    uint32_t alive = 0;
+};
+
+static Snapshot Snap(const FrameGraph& fg, const FrameGraph::CompiledPlan& plan) {
+    Snapshot s{ plan.sorted, plan.mapping, plan.memoryBytes };
+    for (auto& pass : fg.Passes()) s.alive += pass.alive;
+    return s;
+}
+
+int main() {
+    printf("=== Frame Graph: capture & replay ===\n\n");
+    const char* path = "example_capture.fgcap";
+    constexpr uint32_t kFrames = 4;   // the last one with subgraph instances
+
+    // == Record ===================================================
+    FrameGraph fg;
+    fg.SetVerbose(false);
+    ShadowTemplate shadow;
+    FrameCapture capture;
+    fg.SetCapture(&capture);
+    BitsetBlockSearch search;
+    std::vector<Snapshot> original;
+    for (uint32_t frame = 0; frame < kFrames; frame++) {
+        const FrameSettings& set = kSettings[frame];
+        fg.SetHeapTier(set.tier);
+        fg.SetResolutionScale(set.resolutionScale);
+        BuildFrame(fg, frame * 2, frame + 1 == kFrames ? &shadow : nullptr);
+        auto plan = CompileWith(fg, set.indexedSearch, set.budget, search);
+        original.push_back(Snap(fg, plan));
+        fg.Execute(plan);
+    }
+    fg.SetCapture(nullptr);
+    bool ok = capture.FrameCount() == kFrames && capture.Save(path);
+    printf("  Captured %u frames in %zu bytes -> %s\n", capture.FrameCount(),
+           capture.Bytes(), path);
+
+    // == Reload and replay ========================================
+    // Instances replay as instances: scheduled pass by pass instead, the
+    // cascades would interleave and the sorted order would not match.
+    FrameCapture loaded;
+    ok = ok && loaded.Load(path) && loaded.FrameCount() == kFrames;
+    for (uint32_t frame = 0; ok && frame < kFrames; frame++) {
+        FrameGraph replay;
+        replay.SetVerbose(false);
+        SimCosts costs;
+        CapturedCompile settings;
+        ok = loaded.Replay(frame, replay, &costs, &settings);
+        if (!ok) break;
+        const FrameSettings& set = kSettings[frame];
+        bool restored = settings.recorded && settings.tier == set.tier
+                     && settings.indexedSearch == set.indexedSearch
+                     && settings.budgeted == (set.budget != 0) && settings.memoryBudget == set.budget
+                     && settings.resolutionScale == set.resolutionScale
+                     && replay.Tier() == set.tier
+                     && replay.ResolutionScale() == set.resolutionScale;
+        auto plan = CompileWith(replay, settings.indexedSearch,
+                                settings.budgeted ? settings.memoryBudget : 0, search);
+        Snapshot s = Snap(replay, plan);
+        const Snapshot& o = original[frame];
+        bool same = restored && s.sorted == o.sorted && s.mapping == o.mapping
+                 && s.memoryBytes == o.memoryBytes && s.alive == o.alive;
+
+        // Captured timings: live passes measured, culled ones left at default.
+        SimReport sim = SimulateTimeline(replay, plan, costs);
+        bool timed = true;
+        for (uint32_t p = 0; p < replay.Passes().size(); p++)
+            if (replay.Passes()[p].alive) timed = timed && costs.passUs[p] != costs.defaultPassUs;
+
+        printf("  frame %u: %2zu passes, plan %s, simulated %.0f us from captured timings%s\n",
+               frame, replay.Passes().size(), same ? "identical" : "MISMATCH",
+               sim.frameUs, timed ? "" : " (MISSING)");
+        ok = same && timed;
+    }
+
+    // A truncated file must be rejected, not half-replayed.
+    std::vector<char> data(capture.Bytes() + 5);   // magic + version + stream
+    if (FILE* f = fopen(path, "rb")) {
+        size_t got = fread(data.data(), 1, data.size(), f);
+        fclose(f);
+        if ((f = fopen(path, "wb"))) { fwrite(data.data(), 1, got - 3, f); fclose(f); }
+    }
+    FrameCapture broken;
+    bool rejected = !broken.Load(path);
+    printf("  Truncated capture rejected: %s\n", rejected ? "yes" : "NO");
+    ok = ok && rejected;
+
+    // So must out-of-range enums: one tiny frame per bad field.
+    const struct { const char* field; std::vector<uint8_t> ops; } badEnums[] = {
+        //                     kCreate type  w     h  format dyn  kEndFrame
+        { "ResourceType",    { 1,      2,    64,   64, 0,     0,   7 } },
+        { "Format",          { 1,      0,    64,   64, 9,     0,   7 } },
+        //                     kCreate Buffer size stride usage
+        { "BufferUsage",     { 1,      1,    64,  4,     3,        7 } },
+        //                     kImport Texture w   h  format dyn state
+        { "ResourceState",   { 2,      0,    64, 64, 0,     0,  7,    7 } },
+        //                     kAddPass kind len name
+        { "PassKind",        { 3,       2,   1,  'P',                 7 } },
+        //                     kCompile tier flags budget scale (1.0f)
+        { "HeapTier",        { 9,        2,   0,    0,      0x80, 0x80, 0x80, 0xFC, 0x03, 7 } },
+    };
+    for (auto& bad : badEnums) {
+        if (FILE* f = fopen(path, "wb")) {
+            const uint8_t header[5] = { 'F', 'G', 'C', 'P', 3 };
+            fwrite(header, 1, sizeof(header), f);
+            fwrite(bad.ops.data(), 1, bad.ops.size(), f);
+            fclose(f);
+        }
+        bool refused = !broken.Load(path);
+        printf("  Capture with a bad %-13s rejected: %s\n", bad.field, refused ? "yes" : "NO");
+        ok = ok && refused;
+    }
+    capture.Save(path);   // leave a valid capture for replay_tool
+
+    printf("\n%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// Frame Graph -- dynamic resolution without reallocation
+// Compile: g++ -std=c++17 -O2 -o example_dynres example_dynres.cpp frame_graph_v3.cpp frame_graph_pool.cpp frame_graph_descriptors.cpp
+#include "example_v3_frame.h"
+#include "frame_graph_descriptors.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// The example_v3 pipeline (with LightCulling) with its scene targets
+// rendered at 50-100% of 1920x1080, changing every frame. Built two
+// ways: dynamicResolution targets at max size plus SetResolutionScale(),
+// and the naive way that rewrites each ResourceDesc's width/height every
+// frame.
+
+static constexpr uint32_t kFrames = 240;
+static constexpr uint32_t kMaxW   = 1920;   // example_v3's targets
+
+struct SeenExtents {
+    Extent gbuffer, bloom;
+};
+
+struct RunResult {
+    uint32_t poolAllocations      = 0;   // after the first frame
+    uint64_t descriptorsCreated   = 0;   // after the first frame
+    uint32_t planChanges          = 0;   // frames whose memory layout differed
+    uint32_t retiredFreed         = 0;   // replaced allocations released
+    bool     extentsOk            = true;
+};
+
+static RunResult Run(bool dynamic) {
+    FrameGraph fg;
+    fg.SetVerbose(false);
+    HeapPool        pool;
+    DescriptorCache descriptors(pool);
+    fg.AddHook(&pool);
+    fg.AddHook(&descriptors);
+    RunResult r;
+
+    V3Frame     handles;
+    SeenExtents seen;
+    V3FrameOptions opt;
+    opt.echo              = false;
+    opt.lightCulling      = true;
+    opt.dynamicResolution = dynamic;
+    opt.onExecute = [&](const char* pass) {
+        if (!strcmp(pass, "GBuffer")) seen.gbuffer = ActiveExtent(fg, handles.gbufA);
+        if (!strcmp(pass, "Bloom"))   seen.bloom   = ActiveExtent(fg, handles.bloom);
+    };
+    uint32_t allocationsFirst = 0;
+    uint64_t createdFirst     = 0;
+    std::vector<PhysicalBlock> prevBlocks;
+
+    for (uint32_t frame = 0; frame < kFrames; frame++) {
+        // Scaler output: sweeps 50%..100% and back, quantized to 1%.
+        float scale = 0.75f + 0.25f * std::sin(frame * 0.1f);
+        scale = std::round(scale * 100.0f) / 100.0f;
+
+        seen      = {};
+        opt.scale = dynamic ? 1.0f : scale;
+        handles   = DeclareV3Frame(fg, opt);
+        fg.SetResolutionScale(dynamic ? scale : 1.0f);
+        auto plan = fg.Compile();
+
+        bool changed = plan.blocks.size() != prevBlocks.size();
+        for (uint32_t i = 0; !changed && i < plan.blocks.size(); i++)
+            changed = plan.blocks[i].sizeBytes != prevBlocks[i].sizeBytes;
+        if (frame > 0 && changed) r.planChanges++;
+        prevBlocks = plan.blocks;
+
+        fg.Execute(plan);
+
+        // Passes must see the scaled extent either way.
+        uint32_t w = static_cast<uint32_t>(kMaxW * scale + 0.5f);
+        uint32_t bw = static_cast<uint32_t>(kMaxW / 2 * scale + 0.5f);
+        r.extentsOk = r.extentsOk && seen.gbuffer.width == w && seen.bloom.width == bw;
+
+        if (frame == 0) {
+            allocationsFirst = pool.Stats().allocations;
+            createdFirst     = descriptors.Stats().createdTotal;
+        }
+    }
+    r.poolAllocations    = pool.Stats().allocations - allocationsFirst;
+    r.retiredFreed       = pool.Stats().freed;
+    r.descriptorsCreated = descriptors.Stats().createdTotal - createdFirst;
+    return r;
+}
+
+int main() {
+    printf("=== Frame Graph: dynamic resolution (%u frames, 50-100%%) ===\n\n", kFrames);
+
+    RunResult naive   = Run(false);
+    RunResult dynamic = Run(true);
+
+    auto Print = [](const char* name, const RunResult& r) {
+        printf("  %-22s %3u plan changes, %3u heap (re)allocations, "
+               "%4llu descriptors created, %3u old blocks freed  %s\n",
+               name, r.planChanges, r.poolAllocations,
+               static_cast<unsigned long long>(r.descriptorsCreated), r.retiredFreed,
+               r.extentsOk ? "" : "(wrong extents)");
+    };
+    Print("resized descs:", naive);
+    Print("max size + scale:", dynamic);
+
+    bool ok = dynamic.extentsOk && naive.extentsOk && dynamic.planChanges == 0
+           && dynamic.poolAllocations == 0 && dynamic.descriptorsCreated == 0;
+    printf("\n%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+// Frame Graph -- declaring a 5k-pass frame from parallel jobs
+// Compile: g++ -std=c++17 -O2 -pthread -o example_parallel_decl example_parallel_decl.cpp frame_graph_v3.cpp frame_graph_tasks.cpp frame_graph_builder.cpp
+#include "frame_graph_builder.h"
+#include "frame_graph_tasks.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// kSystems subsystems of kPassesPerSystem passes: a chain of local
+// transients with a few longer-range reads, the first pass reading the
+// previous subsystem's shared output and the last writing its own.
+static constexpr uint32_t kSystems        = 8;
+static constexpr uint32_t kPassesPerSystem = 625;   // 5000 passes total
+
+// What a real setup does besides declaring: look up materials, pick
+// shader permutations, size dispatches...
+static uint32_t SetupWork(uint32_t seed) {
+    uint32_t h = seed * 2654435761u;
+    for (uint32_t i = 0; i < 400; i++) h = (h ^ (h >> 13)) * 0x5bd1e995u + i;
+    return h;
+}
+static std::atomic<uint32_t> gSink{0};
+
+struct Shared {
+    std::vector<ResourceHandle> outputs;   // one per subsystem
+    ResourceHandle backbuffer;
+};
+
+static Shared CreateShared(FrameGraph& fg) {
+    Shared s;
+    s.backbuffer = fg.ImportResource({1920, 1080, Format::RGBA8}, ResourceState::Present);
+    for (uint32_t sys = 0; sys < kSystems; sys++)
+        s.outputs.push_back(fg.CreateResource({1920, 1080, Format::RGBA16F}));
+    return s;
+}
+
+static ResourceDesc LocalDesc(uint32_t i) {
+    return i % 3 == 0 ? BufferDesc(256 * 1024 * (i % 7 + 1), 16)
+                      : ResourceDesc{ 512u << (i % 3), 512u << (i % 2), Format::RGBA8 };
+}
+
+static std::string PassName(uint32_t sys, uint32_t i) {
+    return "Sys" + std::to_string(sys) + "/Pass" + std::to_string(i);
+}
+
+// == Serial: straight into the FrameGraph ======================
+static void DeclareSerial(FrameGraph& fg, const Shared& sh, uint32_t sys) {
+    std::vector<ResourceHandle> local;
+    for (uint32_t i = 0; i < kPassesPerSystem; i++) local.push_back(fg.CreateResource(LocalDesc(i)));
+
+    uint32_t base = static_cast<uint32_t>(fg.Passes().size());
+    for (uint32_t i = 0; i < kPassesPerSystem; i++) {
+        uint32_t p = base + i;
+        fg.AddPass(PassName(sys, i),
+            [&]() {
+                gSink += SetupWork(p);
+                if (i == 0 && sys > 0) fg.Read(p, sh.outputs[sys - 1]);
+                if (i > 0) fg.Read(p, local[i - 1]);
+                if (i >= 7) fg.Read(p, local[i - 7]);
+                fg.Write(p, local[i]);
+                if (i + 1 == kPassesPerSystem) fg.Write(p, sh.outputs[sys]);
+            },
+            [](/*cmd*/) {});
+    }
+}
+
+// == Parallel: one builder per subsystem =======================
+static void DeclareBuilder(GraphBuilder& b, const Shared& sh, uint32_t sys) {
+    std::vector<BuilderResource> local;
+    for (uint32_t i = 0; i < kPassesPerSystem; i++) local.push_back(b.CreateResource(LocalDesc(i)));
+
+    for (uint32_t i = 0; i < kPassesPerSystem; i++) {
+        b.AddPass(PassName(sys, i),
+            [&](PassBuilder& pb) {
+                gSink += SetupWork(sys * kPassesPerSystem + i);
+                if (i == 0 && sys > 0) pb.Read(sh.outputs[sys - 1]);
+                if (i > 0) pb.Read(local[i - 1]);
+                if (i >= 7) pb.Read(local[i - 7]);
+                pb.Write(local[i]);
+                if (i + 1 == kPassesPerSystem) pb.Write(sh.outputs[sys]);
+            },
+            [](/*cmd*/) {});
+    }
+}
+
+static void DeclarePresent(FrameGraph& fg, const Shared& sh) {
+    uint32_t p = static_cast<uint32_t>(fg.Passes().size());
+    fg.AddPass("Present",
+        [&]() { for (auto h : sh.outputs) fg.Read(p, h); fg.Write(p, sh.backbuffer); },
+        [](/*cmd*/) {});
+}
+
+struct Timing { double recordUs = 0, mergeUs = 0; };
+
+static double Us(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+static Timing BuildSerial(FrameGraph& fg) {
+    auto t0 = Clock::now();
+    Shared sh = CreateShared(fg);
+    for (uint32_t sys = 0; sys < kSystems; sys++) DeclareSerial(fg, sh, sys);
+    DeclarePresent(fg, sh);
+    return { Us(t0, Clock::now()), 0 };
+}
+
+// scheduler == nullptr: fill the builders one after another on this thread.
+static Timing BuildWithBuilders(FrameGraph& fg, TaskScheduler* scheduler) {
+    std::vector<GraphBuilder> builders(kSystems);
+    auto t0 = Clock::now();
+    Shared sh = CreateShared(fg);
+    if (scheduler) {
+        std::atomic<uint32_t> remaining{kSystems};
+        scheduler->SetHandler([&](uint32_t sys) {
+            DeclareBuilder(builders[sys], sh, sys);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+        for (uint32_t sys = 0; sys < kSystems; sys++) scheduler->Push(sys);
+        while (remaining.load(std::memory_order_acquire) != 0)
+            if (!scheduler->RunOne()) std::this_thread::yield();
+    } else {
+        for (uint32_t sys = 0; sys < kSystems; sys++) DeclareBuilder(builders[sys], sh, sys);
+    }
+    auto t1 = Clock::now();
+    for (auto& b : builders) fg.Merge(b);   // fixed order, whoever finished first
+    DeclarePresent(fg, sh);
+    return { Us(t0, t1), Us(t1, Clock::now()) };
+}
+
+int main() {
+    uint32_t hw = std::max(1u, std::thread::hardware_concurrency());
+    printf("=== Frame Graph: parallel declaration (%u passes, %u hardware threads) ===\n\n",
+           kSystems * kPassesPerSystem + 1, hw);
+
+    // == Same plan as serial declaration ===========================
+    bool ok = true;
+    {
+        TaskScheduler scheduler(std::max(hw - 1, 3u));
+        FrameGraph a, b;
+        a.SetVerbose(false);
+        b.SetVerbose(false);
+        BuildSerial(a);
+        BuildWithBuilders(b, &scheduler);
+        auto planA = a.Compile();
+        auto planB = b.Compile();
+        ok = planA.sorted == planB.sorted && planA.mapping == planB.mapping
+          && planA.memoryBytes == planB.memoryBytes && a.Passes().size() == b.Passes().size();
+        // Merge pre-resolves builder-internal edges, so compare each
+        // pass's dependencies as a set.
+        auto Deps = [](const RenderPass& pass) {
+            std::vector<uint32_t> deps = pass.dependsOn;
+            std::sort(deps.begin(), deps.end());
+            deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+            return deps;
+        };
+        for (uint32_t i = 0; ok && i < a.Passes().size(); i++)
+            ok = a.Passes()[i].name == b.Passes()[i].name
+              && Deps(a.Passes()[i]) == Deps(b.Passes()[i]);
+        printf("  Merged graph vs serial: %s (%zu passes, %.1f MB aliased)\n\n",
+               ok ? "identical" : "MISMATCH", a.Passes().size(),
+               planA.memoryBytes / (1024.0 * 1024.0));
+    }
+
+    // == Declaration cost ==========================================
+    constexpr uint32_t kReps = 10;
+    auto Best = [&](auto&& build) {
+        Timing best{ 1e30, 1e30 };
+        for (uint32_t r = 0; r < kReps; r++) {
+            FrameGraph fg;
+            fg.SetVerbose(false);
+            Timing t = build(fg);
+            if (t.recordUs + t.mergeUs < best.recordUs + best.mergeUs) best = t;
+        }
+        return best;
+    };
+
+    Timing serial = Best([](FrameGraph& fg) { return BuildSerial(fg); });
+    printf("  %-24s %8.0f us\n", "serial AddPass:", serial.recordUs);
+
+    Timing oneThread = Best([](FrameGraph& fg) { return BuildWithBuilders(fg, nullptr); });
+    printf("  %-24s %8.0f us  (record %.0f + merge %.0f)\n", "builders, 1 thread:",
+           oneThread.recordUs + oneThread.mergeUs, oneThread.recordUs, oneThread.mergeUs);
+
+    for (uint32_t workers : { 1u, 3u, 7u }) {
+        TaskScheduler scheduler(workers);
+        Timing t = Best([&](FrameGraph& fg) { return BuildWithBuilders(fg, &scheduler); });
+        char label[40];
+        snprintf(label, sizeof(label), "builders, %u threads:", workers + 1);
+        printf("  %-24s %8.0f us  (record %.0f + merge %.0f)  %.2fx vs serial\n", label,
+               t.recordUs + t.mergeUs, t.recordUs, t.mergeUs,
+               serial.recordUs / (t.recordUs + t.mergeUs));
+    }
+
+    // Merge is the serial fraction: with enough cores the record phase
+    // shrinks toward record/threads and the frame is bounded by merge.
+    printf("\n  Serial fraction (merge): %.0f%% -> at most %.1fx from parallel recording\n",
+           100.0 * oneThread.mergeUs / (oneThread.recordUs + oneThread.mergeUs),
+           (oneThread.recordUs + oneThread.mergeUs) / oneThread.mergeUs);
+
+    printf("\n%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+// Frame Graph -- subgraph templates: one shadow chain, many views
+// Compile: g++ -std=c++17 -O2 -o example_subgraph example_subgraph.cpp frame_graph_v3.cpp frame_graph_subgraph.cpp frame_graph_budget.cpp
+#include "frame_graph_subgraph.h"
+#include "frame_graph_budget.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Per view: depth -> moments -> blur H -> blur V into the view's shadow
+// map; a final Lighting pass reads every shadow map. Built two ways —
+// redeclared per view with AddPass, and instanced from one template.
+
+static constexpr uint32_t kPassesPerView = 4;
+
+static std::vector<ResourceHandle> DeclareOutputs(FrameGraph& fg, uint32_t views) {
+    std::vector<ResourceHandle> maps;
+    for (uint32_t v = 0; v < views; v++)
+        maps.push_back(fg.CreateResource({1024, 1024, Format::RGBA16F}));
+    return maps;
+}
+
+static void DeclareLighting(FrameGraph& fg, const std::vector<ResourceHandle>& maps) {
+    auto backbuffer = fg.ImportResource({1920, 1080, Format::RGBA8},
+                                        ResourceState::Present);
+    uint32_t p = static_cast<uint32_t>(fg.Passes().size());
+    fg.AddPass("Lighting",
+        [&]() { for (auto h : maps) fg.Read(p, h); fg.Write(p, backbuffer); },
+        [](/*cmd*/) {});
+}
+
+// == Redeclared: every view runs its setup lambdas again ========
+static void BuildRedeclared(FrameGraph& fg, uint32_t views, uint32_t& executed) {
+    auto maps = DeclareOutputs(fg, views);
+    for (uint32_t v = 0; v < views; v++) {
+        auto depth   = fg.CreateResource({2048, 2048, Format::D32F});
+        auto moments = fg.CreateResource({1024, 1024, Format::RGBA16F});
+        auto blurTmp = fg.CreateResource({1024, 1024, Format::RGBA16F});
+        auto out     = maps[v];
+        std::string tag = "[" + std::to_string(v) + "]";
+        uint32_t p = static_cast<uint32_t>(fg.Passes().size());
+
+        fg.AddPass("Shadow/Depth" + tag,
+            [&]() { fg.Write(p, depth); },
+            [&executed]() { executed++; });
+        fg.AddPass("Shadow/Moments" + tag,
+            [&]() { fg.Read(p + 1, depth); fg.Write(p + 1, moments); },
+            [&executed]() { executed++; });
+        fg.AddPass("Shadow/BlurH" + tag,
+            [&]() { fg.Read(p + 2, moments); fg.Write(p + 2, blurTmp); },
+            [&executed]() { executed++; });
+        fg.AddPass("Shadow/BlurV" + tag,
+            [&]() { fg.Read(p + 3, blurTmp); fg.Write(p + 3, out); },
+            [&executed]() { executed++; });
+    }
+    DeclareLighting(fg, maps);
+}
+
+// == Instanced: one template, compiled once ====================
+struct ShadowTemplate {
+    SubgraphTemplate tmpl{"Shadow"};
+    SubgraphSlot depth, moments, blurTmp, out;
+    std::vector<uint32_t> seenView;   // view index seen by each executed pass
+
+    ShadowTemplate() {
+        depth   = tmpl.Transient({2048, 2048, Format::D32F});
+        moments = tmpl.Transient({1024, 1024, Format::RGBA16F});
+        blurTmp = tmpl.Transient({1024, 1024, Format::RGBA16F});
+        out     = tmpl.External();
+
+        auto Record = [this](const SubgraphView& v) { seenView.push_back(v.viewIndex); };
+        tmpl.AddPass("Depth",   [&]() { tmpl.Write(0, depth); }, Record);
+        tmpl.AddPass("Moments", [&]() { tmpl.Read(1, depth); tmpl.Write(1, moments); }, Record);
+        tmpl.AddPass("BlurH",   [&]() { tmpl.Read(2, moments); tmpl.Write(2, blurTmp); }, Record);
+        tmpl.AddPass("BlurV",   [&]() { tmpl.Read(3, blurTmp); tmpl.Write(3, out); }, Record);
+        tmpl.Compile();
+    }
+};
+
+static std::vector<SubgraphInstance> BuildInstanced(FrameGraph& fg, ShadowTemplate& shadow,
+                                                    uint32_t views) {
+    auto maps = DeclareOutputs(fg, views);
+    std::vector<SubgraphInstance> instances;
+    for (uint32_t v = 0; v < views; v++)
+        instances.push_back(fg.Instantiate(shadow.tmpl,
+                                           SubgraphBindings(v).Bind(shadow.out, maps[v])));
+    DeclareLighting(fg, maps);
+    return instances;
+}
+
+// == Timing ====================================================
+struct Cost { double declareUs = 0, compileUs = 0; };
+
+template <typename BuildFn>
+static Cost Measure(uint32_t reps, BuildFn&& build) {
+    Cost c;
+    for (uint32_t r = 0; r < reps; r++) {
+        FrameGraph fg;
+        fg.SetVerbose(false);
+        auto t0 = Clock::now();
+        build(fg);
+        auto t1 = Clock::now();
+        auto plan = fg.Compile();
+        auto t2 = Clock::now();
+        c.declareUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        c.compileUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+    }
+    c.declareUs /= reps;
+    c.compileUs /= reps;
+    return c;
+}
+
+int main() {
+    printf("=== Frame Graph: subgraph templates ===\n\n");
+    bool ok = true;
+
+    // == Instances compile as units ================================
+    // Each instance is sorted, culled, scanned and aliased as one unit
+    // from its template's plan, so the instanced plan differs from the
+    // redeclared one (views run one after another instead of
+    // interleaved). It must still be a valid plan for the same graph.
+    for (uint32_t views : { 1u, 4u, 16u }) {
+        FrameGraph a, b;
+        a.SetVerbose(false);
+        b.SetVerbose(false);
+        uint32_t executed = 0;
+        ShadowTemplate shadow;
+        BuildRedeclared(a, views, executed);
+        auto instances = BuildInstanced(b, shadow, views);
+        auto planA = a.Compile();
+        auto planB = b.Compile();
+        const auto& passes = b.Passes();
+
+        // Same passes, same culling; every dependency runs first.
+        bool valid = planA.sorted.size() == planB.sorted.size();
+        std::vector<uint32_t> pos(passes.size());
+        for (uint32_t i = 0; valid && i < planB.sorted.size(); i++) pos[planB.sorted[i]] = i;
+        for (uint32_t p = 0; valid && p < passes.size(); p++) {
+            valid = passes[p].name == a.Passes()[p].name
+                 && passes[p].alive == a.Passes()[p].alive;
+            for (uint32_t dep : passes[p].dependsOn) valid = valid && pos[dep] < pos[p];
+        }
+
+        // Each instance stays in one piece, sees its own view and handles.
+        for (uint32_t v = 0; valid && v < views; v++) {
+            const SubgraphInstance& inst = instances[v];
+            for (uint32_t k = 0; k < inst.passCount; k++)
+                valid = valid && pos[inst.firstPass + k] == pos[inst.firstPass] + k;
+            valid = valid && inst.view->viewIndex == v && inst.passCount == kPassesPerView
+                 && passes[inst.firstPass + kPassesPerView - 1].writes[0].index
+                    == (*inst.view)[shadow.out].index;
+        }
+
+        // Resources sharing a physical block are never live together.
+        for (uint32_t r = 0; valid && r < planB.mapping.size(); r++) {
+            for (uint32_t q = r + 1; q < planB.mapping.size(); q++) {
+                if (planB.mapping[r] == UINT32_MAX || planB.mapping[r] != planB.mapping[q])
+                    continue;
+                const Lifetime& x = planB.lifetimes[r];
+                const Lifetime& y = planB.lifetimes[q];
+                valid = valid && (x.lastUse < y.firstUse || y.lastUse < x.firstUse);
+            }
+        }
+
+        // The template's precomputed barriers match a pass-by-pass walk.
+        BarrierSchedule schedule = b.PlanBarriers(planB);
+        std::vector<ResourceState> state;
+        for (auto& e : b.Entries()) state.push_back(e.currentState);
+        for (uint32_t p : planB.sorted) {
+            if (!passes[p].alive) continue;
+            std::vector<Barrier> expected;
+            auto Walk = [&](ResourceHandle h, bool isWrite) {
+                ResourceState needed = StateForAccess(b.Entries()[h.index].desc, isWrite);
+                if (state[h.index] != needed) expected.push_back({ h.index, state[h.index], needed });
+                state[h.index] = needed;
+            };
+            for (auto& h : passes[p].reads)  Walk(h, false);
+            for (auto& h : passes[p].writes) Walk(h, true);
+            valid = valid && expected.size() == schedule.Count(p);
+            for (uint32_t i = 0; valid && i < expected.size(); i++) {
+                const Barrier& got = schedule.barriers[schedule.first[p] + i];
+                valid = got.resource == expected[i].resource
+                     && got.before == expected[i].before && got.after == expected[i].after;
+            }
+        }
+        valid = valid && planB.memoryBytes <= planA.memoryBytes;
+
+        a.Execute(planA);
+        b.Execute(planB);
+        valid = valid && executed == views * kPassesPerView
+             && shadow.seenView.size() == views * kPassesPerView;
+        std::vector<uint32_t> perView(views, 0);
+        for (uint32_t v : shadow.seenView) if (v < views) perView[v]++;
+        for (uint32_t n : perView) valid = valid && n == kPassesPerView;
+
+        printf("  %2u views: %3zu passes, %6.1f MB aliased (redeclared %6.1f MB)  %s\n",
+               views, planB.sorted.size(), planB.memoryBytes / (1024.0 * 1024.0),
+               planA.memoryBytes / (1024.0 * 1024.0), valid ? "(valid plan)" : "INVALID");
+        ok = ok && valid;
+    }
+
+    // == Packing instances =========================================
+    // An instance sorts as one unit, so each view finishes before the
+    // next starts: the 16 shadow maps (128 MB) stay live for Lighting
+    // and the per-view temporaries fold into one set, within budget
+    // without rescheduling.
+    {
+        FrameGraph fg;
+        fg.SetVerbose(false);
+        ShadowTemplate shadow;
+        BuildInstanced(fg, shadow, 16);
+        auto plan = fg.CompileWithinBudget(160ull * 1024 * 1024);
+        printf("  16 views under a 160 MB budget: %.1f MB%s\n",
+               plan.memoryBytes / (1024.0 * 1024.0), plan.overBudget ? " (over)" : "");
+        ok = ok && !plan.overBudget;
+    }
+
+    // == Per-view CPU cost ========================================
+    // The template's own declare + Compile() is paid once, up front.
+    // Both columns stay roughly flat per view: an instance still adds
+    // real passes and resources, the template only makes each cheaper.
+    ShadowTemplate shadow;
+    printf("\n  views   redeclare us/view   instance us/view   (declare / compile)\n");
+    for (uint32_t views : { 1u, 4u, 16u, 64u, 256u }) {
+        uint32_t reps = 4096 / views;
+        uint32_t executed = 0;
+        Cost redecl = Measure(reps, [&](FrameGraph& fg) { BuildRedeclared(fg, views, executed); });
+        Cost inst   = Measure(reps, [&](FrameGraph& fg) { BuildInstanced(fg, shadow, views); });
+        printf("  %5u   %6.2f / %6.2f     %6.2f / %6.2f      declare %.1fx, compile %.1fx faster\n",
+               views, redecl.declareUs / views, redecl.compileUs / views,
+               inst.declareUs / views, inst.compileUs / views,
+               redecl.declareUs / inst.declareUs, redecl.compileUs / inst.compileUs);
+    }
+
+    printf("\n%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
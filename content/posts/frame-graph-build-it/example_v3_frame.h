@@ -0,0 +1,102 @@
+#pragma once
+// Frame Graph MVP v3 -- the example frame
+// Declared once here so example_v3 and the examples that build on its
+// pipeline (static, sim, descriptors, dynres) all declare the same graph.
+#include "frame_graph_v3.h"
+#include <cstdio>
+#include <functional>
+
+// Defaults give the article's run: 7 passes, 7 resources, no buffers.
+struct V3FrameOptions {
+    bool     echo         = true;    // each pass prints "  >> exec: <name>"
+    bool     lightCulling = false;   // + LightCulling, writing a structured buffer
+    uint32_t bloomWidth   = 960;
+
+    // Scene targets (everything but the backbuffer) at `scale` of their
+    // size, or at full size flagged dynamicResolution (for ActiveExtent).
+    float scale             = 1.0f;
+    bool  dynamicResolution = false;
+
+    std::function<void(const char* pass)> onExecute;   // after the echo
+};
+
+// Handles in declaration order; `lights` only with lightCulling.
+struct V3Frame {
+    ResourceHandle backbuffer, depth, gbufA, gbufN, hdr, bloom, debug, lights;
+};
+
+inline V3Frame DeclareV3Frame(FrameGraph& fg, const V3FrameOptions& opt = {}) {
+    auto Exec = [&opt](const char* name) {
+        return [echo = opt.echo, hook = opt.onExecute, name](/*cmd*/) {
+            if (echo) printf("  >> exec: %s\n", name);
+            if (hook) hook(name);
+        };
+    };
+    auto Target = [&](uint32_t w, uint32_t h, Format f) {
+        ResourceDesc d{ w, h, f };
+        if (opt.dynamicResolution) {
+            d.dynamicResolution = true;
+        } else if (opt.scale != 1.0f) {
+            d.width  = static_cast<uint32_t>(w * opt.scale + 0.5f);
+            d.height = static_cast<uint32_t>(h * opt.scale + 0.5f);
+        }
+        return fg.CreateResource(d);
+    };
+    V3Frame r;
+
+    // Import the swapchain backbuffer — externally owned.
+    // The graph tracks barriers but won't alias it.
+    r.backbuffer = fg.ImportResource({1920, 1080, Format::RGBA8},
+                                     ResourceState::Present);
+
+    r.depth = Target(1920, 1080, Format::D32F);
+    r.gbufA = Target(1920, 1080, Format::RGBA8);
+    r.gbufN = Target(1920, 1080, Format::RGBA8);
+    r.hdr   = Target(1920, 1080, Format::RGBA16F);
+    r.bloom = Target(opt.bloomWidth, 540, Format::RGBA16F);
+    r.debug = Target(1920, 1080, Format::RGBA8);
+
+    // Structured buffer — 4096 lights x 64 B, aliases like any texture.
+    if (opt.lightCulling) r.lights = fg.CreateResource(BufferDesc(4096 * 64, 64));
+
+    uint32_t pass = 0;
+    fg.AddPass("DepthPrepass",
+        [&, p = pass++]() { fg.Write(p, r.depth); },
+        Exec("DepthPrepass"));
+
+    fg.AddPass("GBuffer",
+        [&, p = pass++]() { fg.Read(p, r.depth); fg.Write(p, r.gbufA); fg.Write(p, r.gbufN); },
+        Exec("GBuffer"));
+
+    if (opt.lightCulling) {
+        fg.AddPass("LightCulling",
+            [&, p = pass++]() { fg.Read(p, r.depth); fg.Write(p, r.lights); },
+            Exec("LightCulling"));
+    }
+
+    fg.AddPass("Lighting",
+        [&, p = pass++]() {
+            fg.Read(p, r.gbufA); fg.Read(p, r.gbufN);
+            if (opt.lightCulling) fg.Read(p, r.lights);
+            fg.Write(p, r.hdr); },
+        Exec("Lighting"));
+
+    fg.AddPass("Bloom",
+        [&, p = pass++]() { fg.Read(p, r.hdr); fg.Write(p, r.bloom); },
+        Exec("Bloom"));
+
+    fg.AddPass("Tonemap",
+        [&, p = pass++]() { fg.Read(p, r.bloom); fg.Write(p, r.hdr); },
+        Exec("Tonemap"));
+
+    // Present — reads HDR, writes to imported backbuffer.
+    fg.AddPass("Present",
+        [&, p = pass++]() { fg.Read(p, r.hdr); fg.Write(p, r.backbuffer); },
+        Exec("Present"));
+
+    // Dead pass — nothing reads debug, so the graph will cull it.
+    fg.AddPass("DebugOverlay",
+        [&, p = pass++]() { fg.Write(p, r.debug); },
+        Exec("DebugOverlay"));
+    return r;
+}
@@ -0,0 +1,80 @@
+#include "frame_graph_bitset.h"
+
+namespace {
+
+inline uint32_t LowestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, bits);
+    return static_cast<uint32_t>(idx);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
+
+inline uint32_t SizeClass(uint64_t bytes) {
+    uint32_t c = 0;
+    while (bytes > 1) { bytes >>= 1; c++; }
+    return c;
+}
+
+} // namespace
+
+void BitsetBlockSearch::Begin(const std::vector<PhysicalBlock>& blocks_, HeapTier tier_,
+                              uint32_t passCount) {
+    blocks = &blocks_;
+    tier   = tier_;
+    freeNow.clear();
+    for (auto& m : atLeast) m.clear();
+    for (auto& m : ofType)  m.clear();
+    for (auto& r : releaseAt) r.clear();
+    releaseAt.resize(passCount);
+    cursor = 0;
+}
+
+// A new block starts out occupied.
+void BitsetBlockSearch::AddBlock(uint32_t b) {
+    if (b / 64 >= freeNow.size()) {
+        freeNow.push_back(0);
+        for (auto& m : atLeast) m.push_back(0);
+        for (auto& m : ofType)  m.push_back(0);
+    }
+    const PhysicalBlock& blk = (*blocks)[b];
+    uint64_t bit = uint64_t(1) << (b % 64);
+    for (uint32_t c = 0; c <= SizeClass(blk.sizeBytes); c++)
+        atLeast[c][b / 64] |= bit;
+    ofType[static_cast<int>(blk.heapType)][b / 64] |= bit;
+}
+
+void BitsetBlockSearch::Occupy(uint32_t b, bool isNew, uint32_t lastUse) {
+    if (isNew) AddBlock(b);
+    freeNow[b / 64] &= ~(uint64_t(1) << (b % 64));
+    releaseAt[lastUse].push_back(b);
+}
+
+void BitsetBlockSearch::AdvanceTo(uint32_t firstUse) {
+    for (; cursor < firstUse && cursor < releaseAt.size(); cursor++) {
+        for (uint32_t b : releaseAt[cursor])
+            freeNow[b / 64] |= uint64_t(1) << (b % 64);
+        releaseAt[cursor].clear();
+    }
+}
+
+uint32_t BitsetBlockSearch::FindFirstFit(const Footprint& need, ResourceType type,
+                                         uint32_t firstUse) {
+    AdvanceTo(firstUse);   // AliasResources() asks in firstUse order
+    const auto& large = atLeast[SizeClass(need.sizeBytes)];
+    const auto& typed = ofType[static_cast<int>(type)];
+    for (size_t w = 0; w < freeNow.size(); w++) {
+        uint64_t bits = freeNow[w] & large[w];
+        if (tier == HeapTier::Tier1) bits &= typed[w];
+        while (bits) {
+            uint32_t b = static_cast<uint32_t>(w * 64) + LowestBit(bits);
+            if ((*blocks)[b].sizeBytes >= need.sizeBytes
+                && (*blocks)[b].alignment >= need.alignment)
+                return b;
+            bits &= bits - 1;
+        }
+    }
+    return UINT32_MAX;
+}
@@ -0,0 +1,43 @@
+#pragma once
+// Frame Graph — bitset first-fit block search for very large graphs
+// v3's AliasResources() scans every physical block for each resource,
+// O(R x B). This index keeps one bit per block in a "free right now"
+// set, plus one mask per size class (floor log2 of the size) holding
+// every block at least that large, and one mask per heap type for
+// Tier1. A lookup ANDs 64 blocks per word and only inspects survivors,
+// in block order — the same first-fit answer as the linear scan, so the
+// mapping is identical. Blocks return to the free set when the sweep
+// over firstUse passes their occupant's lastUse.
+//
+// Usage:
+//   BitsetBlockSearch bitset;          // reusable; keeps its capacity
+//   CompileOptions options;
+//   options.blockSearch = &bitset;
+//   auto plan = fg.Compile(options);
+//
+// Compile: g++ -std=c++17 -O2 -o example_alias_bench example_alias_bench.cpp frame_graph_v3.cpp frame_graph_bitset.cpp
+
+#include "frame_graph_v3.h"
+#include <cstdint>
+#include <vector>
+
+class BitsetBlockSearch : public FreeBlockSearch {
+public:
+    void     Begin(const std::vector<PhysicalBlock>& blocks, HeapTier tier,
+                   uint32_t passCount) override;
+    uint32_t FindFirstFit(const Footprint& need, ResourceType type,
+                          uint32_t firstUse) override;
+    void     Occupy(uint32_t block, bool isNew, uint32_t lastUse) override;
+
+private:
+    const std::vector<PhysicalBlock>* blocks = nullptr;
+    HeapTier tier = HeapTier::Tier2;
+    std::vector<uint64_t> freeNow;
+    std::vector<uint64_t> atLeast[64];
+    std::vector<uint64_t> ofType[2];
+    std::vector<std::vector<uint32_t>> releaseAt;   // indexed by lastUse
+    uint32_t cursor = 0;
+
+    void AddBlock(uint32_t b);
+    void AdvanceTo(uint32_t firstUse);   // free blocks whose lastUse < firstUse
+};
@@ -0,0 +1,189 @@
+#include "frame_graph_budget.h"
+#include "frame_graph_subgraph.h"
+#include "frame_graph_trace.h"
+#include <algorithm>
+#include <cstdio>
+
+// == Budgeted compile ==========================================
+
+FrameGraph::CompiledPlan FrameGraph::CompileWithinBudget(uint64_t memoryBudget,
+                                                         const CompileOptions& options) {
+    TraceScope compileScope(tracer, "Compile");
+    if (capture) CaptureCompile(options, true, memoryBudget);
+    CompiledPlan plan = BuildPlan(options);
+    { TraceScope s(tracer, "FitToBudget"); FitToBudget(plan, memoryBudget, options); }
+    FinishPlan(plan);
+    return plan;
+}
+
+// == Reschedule until the aliased total fits ===================
+// Culling already ran on the original order, so every candidate order
+// keeps the same live set; only lifetimes (and so aliasing) change.
+
+void FrameGraph::FitToBudget(CompiledPlan& plan, uint64_t budget,
+                             const CompileOptions& options) {
+    auto MB = [](uint64_t bytes) { return bytes / (1024.0 * 1024.0); };
+
+    Log("[5b] Memory budget %.1f MB, plan needs %.1f MB\n",
+        MB(budget), MB(plan.memoryBytes));
+    if (plan.memoryBytes <= budget) return;
+
+    const struct { MemorySchedule heuristic; const char* name; } attempts[] = {
+        { MemorySchedule::MinLiveMemory, "min-live-memory" },
+        { MemorySchedule::DepthFirst,    "depth-first" },
+    };
+    for (auto& attempt : attempts) {
+        CompiledPlan candidate;
+        candidate.sorted = ScheduleForMemory(attempt.heuristic);
+
+        bool wasVerbose = verbose;
+        verbose = false;
+        candidate.lifetimes = ScanLifetimes(candidate.sorted);
+        candidate.mapping   = AliasResources(candidate.lifetimes, candidate.blocks,
+                                             options.blockSearch);
+        verbose = wasVerbose;
+
+        for (auto& blk : candidate.blocks) candidate.memoryBytes += blk.sizeBytes;
+        Log("  reschedule %-16s %.1f MB\n", attempt.name, MB(candidate.memoryBytes));
+
+        if (candidate.memoryBytes < plan.memoryBytes) plan = std::move(candidate);
+        if (plan.memoryBytes <= budget) break;
+    }
+
+    if (plan.memoryBytes <= budget) {
+        Log("  fits: %.1f MB\n", MB(plan.memoryBytes));
+        return;
+    }
+    // The caller decides whether (and where) to report it.
+    plan.overBudget = true;
+    plan.diagnostic = BudgetDiagnostic(plan, budget);
+    Log("  over budget: %.1f MB, see plan.diagnostic\n", MB(plan.memoryBytes));
+}
+
+// Kahn's algorithm over live passes, with a heuristic choosing among the
+// ready set instead of FIFO order. Dead passes go last; they never run.
+
+std::vector<uint32_t> FrameGraph::ScheduleForMemory(MemorySchedule heuristic) const {
+    const uint32_t n = static_cast<uint32_t>(passes.size());
+
+    // Distinct transient resources each live unit touches — an instance
+    // touches every slot its template uses.
+    std::vector<std::vector<uint32_t>> touches(n);
+    std::vector<uint32_t> usersLeft(entries.size(), 0);
+    std::vector<uint64_t> bytes(entries.size(), 0);
+    for (uint32_t r = 0; r < entries.size(); r++)
+        if (!entries[r].imported) bytes[r] = ResourceFootprint(entries[r].desc).sizeBytes;
+    auto UnitAlive = [&](uint32_t unit) {
+        uint32_t g = passes[unit].group;
+        return g == UINT32_MAX ? passes[unit].alive : groups[g].alive;
+    };
+    for (uint32_t p = 0; p < n; p++) {
+        auto& t = touches[p];
+        if (passes[p].group != UINT32_MAX) {
+            const PassGroup& g = groups[passes[p].group];
+            p = g.firstPass + g.passCount - 1;
+            if (!g.alive) continue;
+            for (uint32_t s = 0; s < g.plan->slotLife.size(); s++)
+                if (g.plan->slotLife[s].firstUse != UINT32_MAX)
+                    t.push_back(g.view->handles[s].index);
+        } else {
+            if (!passes[p].alive) continue;
+            for (auto& h : passes[p].reads)  t.push_back(h.index);
+            for (auto& h : passes[p].writes) t.push_back(h.index);
+        }
+        std::sort(t.begin(), t.end());
+        t.erase(std::unique(t.begin(), t.end()), t.end());
+        t.erase(std::remove_if(t.begin(), t.end(),
+                               [&](uint32_t r) { return entries[r].imported; }), t.end());
+        for (uint32_t r : t) usersLeft[r]++;
+    }
+
+    std::vector<std::vector<uint32_t>> successors;
+    std::vector<uint32_t> inDeg;
+    BuildUnitEdges(successors, inDeg, true);
+
+    std::vector<uint32_t> ready;
+    for (uint32_t p = 0; p < n; p++)
+        if (UnitOf(p) == p && UnitAlive(p) && inDeg[p] == 0) ready.push_back(p);
+
+    std::vector<bool> allocated(entries.size(), false);
+    std::vector<uint32_t> order;
+    while (!ready.empty()) {
+        size_t pick = ready.size() - 1;                  // DepthFirst: LIFO
+        if (heuristic == MemorySchedule::MinLiveMemory) {
+            int64_t best = INT64_MAX;
+            for (size_t i = 0; i < ready.size(); i++) {
+                int64_t delta = 0;
+                for (uint32_t r : touches[ready[i]]) {
+                    if (!allocated[r])       delta += static_cast<int64_t>(bytes[r]);
+                    if (usersLeft[r] == 1)   delta -= static_cast<int64_t>(bytes[r]);
+                }
+                if (delta < best || (delta == best && ready[i] < ready[pick])) {
+                    best = delta;
+                    pick = i;
+                }
+            }
+        }
+        uint32_t cur = ready[pick];
+        ready.erase(ready.begin() + pick);
+        uint32_t count = passes[cur].group == UINT32_MAX ? 1 : groups[passes[cur].group].passCount;
+        for (uint32_t k = 0; k < count; k++) order.push_back(cur + k);
+
+        for (uint32_t r : touches[cur]) {
+            allocated[r] = true;
+            usersLeft[r]--;
+        }
+        for (uint32_t succ : successors[cur])
+            if (--inDeg[succ] == 0) ready.push_back(succ);
+    }
+    // Dead units go last, instances still in one piece.
+    for (uint32_t p = 0; p < n; p++) {
+        if (UnitAlive(UnitOf(p))) continue;
+        if (passes[p].group != UINT32_MAX && UnitOf(p) != p) continue;
+        uint32_t count = passes[p].group == UINT32_MAX ? 1 : groups[passes[p].group].passCount;
+        for (uint32_t k = 0; k < count; k++) order.push_back(p + k);
+    }
+    return order;
+}
+
+// Names the sorted position where the most transient bytes are live
+// and lists what is live there — the pass to split or the resource to
+// shrink.
+
+std::string FrameGraph::BudgetDiagnostic(const CompiledPlan& plan, uint64_t budget) const {
+    auto MB = [](uint64_t bytes) { return bytes / (1024.0 * 1024.0); };
+
+    std::vector<int64_t> delta(plan.sorted.size() + 1, 0);
+    for (uint32_t r = 0; r < plan.lifetimes.size(); r++) {
+        const Lifetime& lt = plan.lifetimes[r];
+        if (!lt.isTransient || lt.firstUse == UINT32_MAX) continue;
+        int64_t size = static_cast<int64_t>(ResourceFootprint(entries[r].desc).sizeBytes);
+        delta[lt.firstUse]    += size;
+        delta[lt.lastUse + 1] -= size;
+    }
+    uint32_t peakPos = 0;
+    int64_t live = 0, peak = 0;
+    for (uint32_t i = 0; i < plan.sorted.size(); i++) {
+        live += delta[i];
+        if (live > peak) { peak = live; peakPos = i; }
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line),
+             "Compile: transient memory %.1f MB exceeds budget %.1f MB.\n"
+             "  Peak at pass '%s' (sorted position %u): %.1f MB live:\n",
+             MB(plan.memoryBytes), MB(budget),
+             passes[plan.sorted[peakPos]].name.c_str(), peakPos, MB(peak));
+    std::string msg = line;
+    for (uint32_t r = 0; r < plan.lifetimes.size(); r++) {
+        const Lifetime& lt = plan.lifetimes[r];
+        if (!lt.isTransient || lt.firstUse == UINT32_MAX) continue;
+        if (lt.firstUse > peakPos || lt.lastUse < peakPos) continue;
+        snprintf(line, sizeof(line), "    resource[%u] %.1f MB, lifetime [%u..%u]\n",
+                 r, MB(ResourceFootprint(entries[r].desc).sizeBytes),
+                 lt.firstUse, lt.lastUse);
+        msg += line;
+    }
+    msg.pop_back();   // trailing newline
+    return msg;
+}
@@ -0,0 +1,23 @@
+#pragma once
+// Frame Graph — memory-budgeted compile
+// A hard ceiling on aliased transient memory. CompileWithinBudget() runs
+// the usual compile; when the plan's blocks add up to more than the
+// budget, it rebuilds the pass order with memory-aware heuristics and
+// keeps the smallest plan. Culling is not repeated, so the live set
+// never changes. If no order fits, the plan comes back overBudget with a
+// diagnostic naming the peak pass and what is live there, and is not
+// handed to anything that would commit memory for it.
+//
+// Usage:
+//   auto plan = fg.CompileWithinBudget(48ull << 20);
+//   if (plan.overBudget) fprintf(stderr, "%s\n", plan.diagnostic.c_str());
+//
+// Compile: g++ -std=c++17 -o example_budget example_budget.cpp frame_graph_v3.cpp frame_graph_budget.cpp
+
+#include "frame_graph_v3.h"
+
+// Pass orders CompileWithinBudget() tries when a plan is over budget.
+enum class MemorySchedule {
+    MinLiveMemory,   // run the ready pass that allocates least / frees most
+    DepthFirst,      // finish one branch before starting the next
+};
@@ -0,0 +1,70 @@
+#include "frame_graph_builder.h"
+#include <cassert>
+#include <iterator>
+
+// == FrameGraph::Merge =========================================
+// Builder resources become graph resources in order; builder passes
+// arrive with their builder-internal edges already resolved and are
+// rebased onto where the builder lands, then moved in as one block.
+// Only accesses to shared handles go through the graph's version
+// tracking, linking them to whichever earlier-merged builder (or
+// main-thread pass) wrote them — the same graph as declaring everything
+// serially in merge order. A capture, if attached, records the merged
+// graph.
+
+void FrameGraph::Merge(GraphBuilder& builder) {
+    const uint32_t firstResource = static_cast<uint32_t>(entries.size());
+    for (const ResourceDesc& desc : builder.resources) CreateResource(desc);
+    builder.firstResource = firstResource;
+
+    const uint32_t base = static_cast<uint32_t>(passes.size());
+    auto Rebase = [&](std::vector<ResourceHandle>& handles) {
+        for (auto& h : handles) {
+            if (h.index & GraphBuilder::kLocal) h.index = firstResource + (h.index & ~GraphBuilder::kLocal);
+            assert(h.index < entries.size() && "Builder used a handle from another graph");
+        }
+    };
+    for (RenderPass& rp : builder.passes) {
+        Rebase(rp.reads);
+        Rebase(rp.writes);
+        for (uint32_t& dep : rp.dependsOn) dep += base;
+        rp.depsUnique = true;
+    }
+
+    for (const auto& acc : builder.shared) {
+        assert(acc.pass < builder.passes.size() && "PassBuilder used outside its pass's setup");
+        uint32_t r = acc.handle.index;
+        uint32_t p = base + acc.pass;
+        if (acc.write) {
+            entries[r].versions.push_back({});
+            entries[r].versions.back().writerPass = p;
+            continue;
+        }
+        auto& ver = entries[r].versions.back();
+        if (ver.HasWriter()) {
+            RenderPass& rp = builder.passes[acc.pass];
+            rp.dependsOn.push_back(ver.writerPass);
+            rp.depsUnique = false;   // may repeat a local edge
+        }
+        ver.readerPasses.push_back(p);
+    }
+
+    // Passes declared after the merge may read a builder resource via
+    // Resolve(): its only version is the one its last writer produced.
+    for (uint32_t r = 0; r < builder.resources.size(); r++) {
+        if (builder.lastWriter[r] != UINT32_MAX)
+            entries[firstResource + r].versions.back().writerPass = base + builder.lastWriter[r];
+    }
+
+    passes.insert(passes.end(), std::make_move_iterator(builder.passes.begin()),
+                                std::make_move_iterator(builder.passes.end()));
+    if (capture) {
+        for (uint32_t p = base; p < passes.size(); p++) CaptureResolvedPass(p);
+    }
+
+    // Resolve() stays valid; the builder is ready for the next frame.
+    builder.resources.clear();
+    builder.lastWriter.clear();
+    builder.passes.clear();
+    builder.shared.clear();
+}
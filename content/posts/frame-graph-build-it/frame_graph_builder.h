@@ -0,0 +1,149 @@
+#pragma once
+// Frame Graph — per-thread graph builders for parallel declaration
+// FrameGraph::AddPass/Read/Write mutate shared vectors and take global
+// pass indices, so declaration is single-threaded. A GraphBuilder records
+// one subsystem's passes privately — resources and passes are builder-
+// local, setup lambdas get a PassBuilder instead of an index — so shadows,
+// post-processing and UI can each fill their own builder in a parallel
+// job. Accesses to builder-local resources are versioned while recording,
+// as SubgraphTemplate does, so the edges inside a builder are resolved on
+// the recording thread. FrameGraph::Merge() then splices builders in, in
+// the order the caller merges them — appending passes with their edges
+// already resolved and versioning only the shared handles — so the graph
+// (and the plan) never depends on which job finished first.
+//
+// Usage:
+//   auto shadowMap = fg.CreateResource({2048, 2048, Format::D32F});  // shared, up front
+//   GraphBuilder shadows, post;
+//   jobs.Run([&] {
+//       shadows.AddPass("Shadow", [&](PassBuilder& pb) { pb.Write(shadowMap); }, drawFn);
+//   });
+//   jobs.Run([&] {
+//       auto tmp = post.CreateResource({1920, 1080, Format::RGBA16F});
+//       post.AddPass("Blur", [&](PassBuilder& pb) { pb.Read(hdr); pb.Write(tmp); }, blurFn);
+//   });
+//   jobs.Wait();
+//   fg.Merge(shadows);   // fixed order = deterministic graph
+//   fg.Merge(post);
+//
+// Resources shared between builders are created on the FrameGraph before
+// the jobs start; builders only read their handles. Merge() is serial.
+//
+// Compile: g++ -std=c++17 -O2 -pthread -o example_parallel_decl example_parallel_decl.cpp frame_graph_v3.cpp frame_graph_tasks.cpp frame_graph_builder.cpp
+
+#include "frame_graph_v3.h"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+class GraphBuilder;
+
+// == Builder-local resource ====================================
+// Only meaningful to the builder that created it: the index is local,
+// so the owner is kept to catch a handle passed to another builder.
+struct BuilderResource {
+    uint32_t            index   = UINT32_MAX;
+    const GraphBuilder* builder = nullptr;
+    bool IsValid() const { return index != UINT32_MAX; }
+};
+
+// == Handed to a pass's setup: accesses for that pass only =====
+class PassBuilder {
+public:
+    void Read(ResourceHandle shared);
+    void Read(BuilderResource local);
+    void Write(ResourceHandle shared);
+    void Write(BuilderResource local);
+
+private:
+    friend class GraphBuilder;
+    PassBuilder(GraphBuilder& builder, uint32_t pass) : builder(builder), pass(pass) {}
+    GraphBuilder& builder;
+    uint32_t      pass;
+};
+
+// == One subsystem's passes, recorded on any one thread ========
+class GraphBuilder {
+public:
+    BuilderResource CreateResource(const ResourceDesc& desc) {
+        resources.push_back(desc);
+        lastWriter.push_back(UINT32_MAX);
+        return { static_cast<uint32_t>(resources.size() - 1), this };
+    }
+
+    template <typename SetupFn, typename ExecFn>
+    void AddPass(const std::string& name, SetupFn&& setup, ExecFn&& exec,
+                 PassKind kind = PassKind::Gpu) {
+        passes.emplace_back();
+        passes.back().name    = name;
+        passes.back().Execute = std::forward<ExecFn>(exec);
+        passes.back().kind    = kind;
+        uint32_t pass = static_cast<uint32_t>(passes.size() - 1);
+        PassBuilder pb(*this, pass);
+        std::forward<SetupFn>(setup)(pb);
+        // Dedup here, on the recording thread, so Merge() needn't.
+        auto& deps = passes[pass].dependsOn;
+        std::sort(deps.begin(), deps.end());
+        deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    }
+
+    uint32_t PassCount() const { return static_cast<uint32_t>(passes.size()); }
+
+    // After FrameGraph::Merge(): the graph handle a local resource became.
+    ResourceHandle Resolve(BuilderResource r) const {
+        assert(r.builder == this && "BuilderResource resolved by another GraphBuilder");
+        return { firstResource + r.index };
+    }
+
+private:
+    friend class FrameGraph;
+    friend class PassBuilder;
+
+    // Passes are recorded as finished RenderPasses: local resources as
+    // kLocal | builder index and dependsOn as builder pass indices, both
+    // rebased in place by Merge() before it moves them into the graph.
+    static constexpr uint32_t kLocal = 0x80000000u;
+
+    // A local handle must come from this builder, and be in range for
+    // what it has recorded since its last Merge().
+    void CheckLocal(BuilderResource r) const {
+        assert(r.builder == this && "BuilderResource used with another GraphBuilder");
+        assert(r.index < resources.size() && "BuilderResource not created since the last Merge()");
+        (void)r;
+    }
+
+    struct SharedAccess {
+        uint32_t       pass;
+        ResourceHandle handle;
+        bool           write;
+    };
+
+    std::vector<ResourceDesc> resources;
+    std::vector<uint32_t>     lastWriter;    // builder pass, by local resource
+    std::vector<RenderPass>   passes;
+    std::vector<SharedAccess> shared;        // versioned by Merge(), in declaration order
+    uint32_t                  firstResource = 0;   // set by Merge()
+};
+
+inline void PassBuilder::Read(ResourceHandle shared) {
+    builder.passes[pass].reads.push_back(shared);
+    builder.shared.push_back({ pass, shared, false });
+}
+inline void PassBuilder::Read(BuilderResource local) {
+    builder.CheckLocal(local);
+    uint32_t writer = builder.lastWriter[local.index];
+    if (writer != UINT32_MAX) builder.passes[pass].dependsOn.push_back(writer);
+    builder.passes[pass].reads.push_back({ GraphBuilder::kLocal | local.index });
+}
+inline void PassBuilder::Write(ResourceHandle shared) {
+    builder.passes[pass].writes.push_back(shared);
+    builder.shared.push_back({ pass, shared, true });
+}
+inline void PassBuilder::Write(BuilderResource local) {
+    builder.CheckLocal(local);
+    builder.lastWriter[local.index] = pass;
+    builder.passes[pass].writes.push_back({ GraphBuilder::kLocal | local.index });
+}
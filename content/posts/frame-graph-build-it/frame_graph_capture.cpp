@@ -0,0 +1,227 @@
+#include "frame_graph_capture.h"
+#include "frame_graph_sim.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// == File layout ===============================================
+// "FGCP", one version byte, then the op stream of complete frames.
+// Version 2 added kGroup, version 3 kCompile; older files still load.
+
+namespace {
+constexpr char    kMagic[4] = { 'F', 'G', 'C', 'P' };
+constexpr uint8_t kVersion  = 3;
+
+// Bounds-checked reader over the op stream.
+struct Reader {
+    const uint8_t* at;
+    const uint8_t* end;
+    bool ok = true;
+
+    uint8_t Byte() {
+        if (at == end) { ok = false; return 0; }
+        return *at++;
+    }
+    uint64_t Var() {
+        uint64_t v = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t b = Byte();
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    std::string Str() {
+        uint64_t n = Var();
+        if (n > static_cast<uint64_t>(end - at)) { ok = false; return {}; }
+        std::string s(reinterpret_cast<const char*>(at), n);
+        at += n;
+        return s;
+    }
+    // Enum fields index tables (BitsetBlockSearch::ofType, StateName...):
+    // anything past the last enumerator rejects the stream.
+    template <typename E>
+    E Enum(E last) {
+        uint64_t v = Var();
+        if (v > static_cast<uint64_t>(last)) { ok = false; return E{}; }
+        return static_cast<E>(v);
+    }
+    ResourceDesc Desc() {
+        ResourceDesc d;
+        d.type = Enum(ResourceType::Buffer);
+        if (d.type == ResourceType::Buffer) {
+            d.byteSize = Var();
+            d.stride   = static_cast<uint32_t>(Var());
+            d.usage    = Enum(BufferUsage::Constant);
+        } else {
+            d.width             = static_cast<uint32_t>(Var());
+            d.height            = static_cast<uint32_t>(Var());
+            d.format            = Enum(Format::D32F);
+            d.dynamicResolution = Var() != 0;
+        }
+        return d;
+    }
+    ResourceState State() { return Enum(ResourceState::Present); }
+    PassKind      Kind()  { return Enum(PassKind::Cpu); }
+    // kCompile's operands: tier, CapturedCompile::Flags, budget, and the
+    // resolution scale's float bits.
+    CapturedCompile Compile() {
+        CapturedCompile c;
+        c.tier = Enum(HeapTier::Tier2);
+        uint64_t flags     = Var();
+        c.memoryBudget     = Var();
+        uint64_t scaleBits = Var();
+        constexpr uint64_t kAllFlags = CapturedCompile::kIndexedSearch | CapturedCompile::kBudgeted;
+        if (flags > kAllFlags || scaleBits > UINT32_MAX) { ok = false; return c; }
+        uint32_t bits = static_cast<uint32_t>(scaleBits);
+        memcpy(&c.resolutionScale, &bits, sizeof(bits));
+        if (!std::isfinite(c.resolutionScale) || c.resolutionScale <= 0.0f) ok = false;
+        c.indexedSearch = (flags & CapturedCompile::kIndexedSearch) != 0;
+        c.budgeted      = (flags & CapturedCompile::kBudgeted) != 0;
+        c.recorded      = ok;
+        return c;
+    }
+};
+}
+
+bool FrameCapture::Save(const char* path) const {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    // Only whole frames: a frame still being recorded is left out.
+    size_t size = frameStarts.back();
+    bool ok = fwrite(kMagic, 1, sizeof(kMagic), f) == sizeof(kMagic)
+           && fwrite(&kVersion, 1, 1, f) == 1
+           && fwrite(bytes.data(), 1, size, f) == size;
+    return fclose(f) == 0 && ok;
+}
+
+bool FrameCapture::Load(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char    magic[4];
+    uint8_t version = 0;
+    bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, kMagic, 4) == 0
+           && fread(&version, 1, 1, f) == 1 && version >= 1 && version <= kVersion;
+    std::vector<uint8_t> data;
+    uint8_t chunk[64 * 1024];
+    size_t n;
+    while (ok && (n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        data.insert(data.end(), chunk, chunk + n);
+    fclose(f);
+    if (!ok) return false;
+
+    // Walk the stream once to find frame boundaries (and reject garbage).
+    std::vector<size_t> starts{ 0 };
+    Reader r{ data.data(), data.data() + data.size() };
+    while (r.ok && r.at != r.end) {
+        switch (r.Byte()) {
+            case kCreate:   r.Desc(); break;
+            case kImport:   r.Desc(); r.State(); break;
+            case kAddPass:  r.Kind(); r.Str(); break;
+            case kRead:
+            case kWrite:
+            case kPassTime:
+            case kGroup:    r.Var(); r.Var(); break;
+            case kCompile:  r.Compile(); break;
+            case kEndFrame: starts.push_back(r.at - data.data()); break;
+            default:        r.ok = false; break;
+        }
+    }
+    if (!r.ok || starts.back() != data.size()) return false;
+
+    bytes       = std::move(data);
+    frameStarts = std::move(starts);
+    return true;
+}
+
+// == Replay ====================================================
+
+bool FrameCapture::Replay(uint32_t frame, FrameGraph& fg, SimCosts* costs,
+                          CapturedCompile* compile) const {
+    if (frame >= FrameCount()) return false;
+    if (!fg.Passes().empty() || !fg.Entries().empty()) return false;
+    Reader r{ bytes.data() + frameStarts[frame], bytes.data() + frameStarts[frame + 1] };
+
+    std::vector<uint64_t> timeNs;
+    CapturedCompile settings;
+    uint32_t resources = 0, passCount = 0;
+    while (r.ok && r.at != r.end) {
+        uint8_t op = r.Byte();
+        switch (op) {
+            case kCreate: {
+                ResourceDesc d = r.Desc();
+                if (!r.ok) return false;
+                fg.CreateResource(d);
+                resources++;
+                break;
+            }
+            case kImport: {
+                ResourceDesc  d     = r.Desc();
+                ResourceState state = r.State();
+                if (!r.ok) return false;
+                fg.ImportResource(d, state);
+                resources++;
+                break;
+            }
+            case kAddPass: {
+                PassKind    kind = r.Kind();
+                std::string name = r.Str();
+                if (!r.ok) return false;
+                fg.AddPass(name, []() {}, [](/*cmd*/) {}, kind);
+                passCount++;
+                break;
+            }
+            case kRead:
+            case kWrite: {
+                bool     write = op == kWrite;
+                uint64_t pass  = r.Var();
+                uint64_t res   = r.Var();
+                if (!r.ok || pass >= passCount || res >= resources) return false;
+                ResourceHandle h{ static_cast<uint32_t>(res) };
+                if (write) fg.Write(static_cast<uint32_t>(pass), h);
+                else       fg.Read(static_cast<uint32_t>(pass), h);
+                break;
+            }
+            case kPassTime: {
+                uint64_t pass = r.Var();
+                uint64_t ns   = r.Var();
+                if (!r.ok || pass >= passCount) return false;
+                if (timeNs.size() <= pass) timeNs.resize(pass + 1, 0);
+                timeNs[pass] += ns;
+                break;
+            }
+            case kGroup: {
+                uint64_t count      = r.Var();
+                uint64_t transients = r.Var();
+                if (!r.ok || count > passCount || transients > resources) return false;
+                if (!fg.GroupPasses(static_cast<uint32_t>(count),
+                                    static_cast<uint32_t>(transients))) return false;
+                break;
+            }
+            case kCompile:
+                settings = r.Compile();
+                if (!r.ok) return false;
+                break;
+            case kEndFrame:
+                break;
+            default:
+                return false;
+        }
+    }
+    if (!r.ok) return false;
+
+    // The last compile wins, as it did when the frame executed.
+    if (settings.recorded) {
+        fg.SetHeapTier(settings.tier);
+        fg.SetResolutionScale(settings.resolutionScale);
+    }
+    if (compile) *compile = settings;
+
+    if (costs) {
+        costs->passUs.assign(passCount, costs->defaultPassUs);
+        for (uint32_t p = 0; p < timeNs.size(); p++)
+            if (timeNs[p]) costs->passUs[p] = timeNs[p] / 1000.0;
+    }
+    return true;
+}
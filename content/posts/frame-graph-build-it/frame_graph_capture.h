@@ -0,0 +1,157 @@
+#pragma once
+// Frame Graph — frame capture and deterministic replay
+// Attach a FrameCapture and every CreateResource, ImportResource,
+// AddPass, Read and Write call is appended to a compact byte stream
+// (LEB128 varints, one opcode byte per call), plus the measured time of
+// each executed pass and the settings each Compile() ran with (heap
+// tier, block search, memory budget, resolution scale). Saved captures
+// rebuild the same FrameGraph offline — same handles, same versions,
+// same plan — so a misbehaving production frame can be compiled and
+// simulated in a loop, or fed to benchmarks.
+//
+// Usage:
+//   FrameCapture capture;
+//   fg.SetCapture(&capture);           // record from the next call on
+//   ... build + execute frames ...
+//   capture.Save("frame.fgcap");
+//
+//   FrameCapture loaded;
+//   loaded.Load("frame.fgcap");
+//   FrameGraph replay;
+//   SimCosts costs;
+//   CapturedCompile settings;
+//   loaded.Replay(0, replay, &costs, &settings);  // graph + timings + settings
+//   ... compile with settings.indexedSearch / settings.memoryBudget ...
+//
+// Pass bodies are not captured; replayed passes execute as no-ops.
+// Subgraph instances replay as instances, scheduled as one unit.
+//
+// Compile: g++ -std=c++17 -O2 -o replay_tool replay_tool.cpp frame_graph_v3.cpp frame_graph_sim.cpp frame_graph_capture.cpp frame_graph_subgraph.cpp frame_graph_budget.cpp frame_graph_bitset.cpp
+
+#include "frame_graph_v3.h"
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct SimCosts;   // frame_graph_sim.h
+
+// How a captured frame was compiled (its last Compile() call). Replay
+// applies the tier and resolution scale to the graph; the compile call
+// is the caller's to make.
+struct CapturedCompile {
+    bool     recorded        = false;   // no: a version 1/2 capture, or never compiled
+    HeapTier tier            = HeapTier::Tier2;
+    bool     indexedSearch   = false;   // compiled with a FreeBlockSearch
+    bool     budgeted        = false;   // CompileWithinBudget(), not Compile()
+    uint64_t memoryBudget    = 0;
+    float    resolutionScale = 1.0f;
+
+    enum Flags : uint8_t { kIndexedSearch = 1, kBudgeted = 2 };   // in the stream
+};
+
+class FrameCapture {
+public:
+    // == Recording: called by FrameGraph while attached ==========
+    void OnCreateResource(const ResourceDesc& desc) {
+        Op(kCreate);
+        PutDesc(desc);
+    }
+    void OnImportResource(const ResourceDesc& desc, ResourceState initial) {
+        Op(kImport);
+        PutDesc(desc);
+        PutVar(static_cast<uint64_t>(initial));
+    }
+    void OnAddPass(const std::string& name, PassKind kind) {
+        Op(kAddPass);
+        PutVar(static_cast<uint64_t>(kind));
+        PutVar(name.size());
+        bytes.insert(bytes.end(), name.begin(), name.end());
+    }
+    void OnRead(uint32_t passIdx, ResourceHandle h)  { Op(kRead);  PutVar(passIdx); PutVar(h.index); }
+    void OnWrite(uint32_t passIdx, ResourceHandle h) { Op(kWrite); PutVar(passIdx); PutVar(h.index); }
+    // The last `passCount` passes and `transientCount` resources before
+    // them form one subgraph instance (FrameGraph::GroupPasses).
+    void OnGroup(uint32_t passCount, uint32_t transientCount) {
+        Op(kGroup);
+        PutVar(passCount);
+        PutVar(transientCount);
+    }
+    void OnCompile(HeapTier tier, const CompileOptions& options, bool budgeted,
+                   uint64_t memoryBudget, float resolutionScale) {
+        Op(kCompile);
+        PutVar(static_cast<uint64_t>(tier));
+        PutVar((options.blockSearch ? CapturedCompile::kIndexedSearch : 0)
+             | (budgeted ? CapturedCompile::kBudgeted : 0));
+        PutVar(memoryBudget);
+        uint32_t scaleBits;
+        memcpy(&scaleBits, &resolutionScale, sizeof(scaleBits));
+        PutVar(scaleBits);
+    }
+
+    // Executors may time passes on worker threads.
+    void OnPassTime(uint32_t passIdx, uint64_t ns) {
+        std::lock_guard<std::mutex> lock(timingLock);
+        Op(kPassTime);
+        PutVar(passIdx);
+        PutVar(ns);
+    }
+    void OnEndFrame() {
+        Op(kEndFrame);
+        frameStarts.push_back(bytes.size());
+    }
+
+    // Off: graph structure only, smaller and free of timing noise.
+    void SetRecordTimings(bool on) { recordTimings = on; }
+    bool RecordsTimings() const { return recordTimings; }
+
+    // == Files ===================================================
+    bool Save(const char* path) const;
+    bool Load(const char* path);
+
+    size_t   Bytes()      const { return bytes.size(); }
+    uint32_t FrameCount() const { return static_cast<uint32_t>(frameStarts.size() - 1); }
+
+    // == Replay ==================================================
+    // Re-issues frame `frame`'s calls on `fg` (which must be empty and
+    // have no capture attached). With `costs`, the frame's pass timings
+    // land in costs->passUs for SimulateTimeline. Returns false if the
+    // frame is missing or the stream is malformed. With `compile`, the
+    // frame's compile settings (see CapturedCompile).
+    bool Replay(uint32_t frame, FrameGraph& fg, SimCosts* costs = nullptr,
+                CapturedCompile* compile = nullptr) const;
+
+private:
+    enum Opcode : uint8_t {
+        kCreate = 1, kImport, kAddPass, kRead, kWrite, kPassTime, kEndFrame, kGroup,
+        kCompile,
+    };
+
+    std::vector<uint8_t> bytes;
+    std::vector<size_t>  frameStarts{ 0 };   // byte offset of each frame
+    std::mutex           timingLock;
+    bool                 recordTimings = true;
+
+    void Op(Opcode op) { bytes.push_back(op); }
+    void PutVar(uint64_t v) {
+        while (v >= 0x80) {
+            bytes.push_back(static_cast<uint8_t>(v) | 0x80);
+            v >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(v));
+    }
+    void PutDesc(const ResourceDesc& d) {
+        PutVar(static_cast<uint64_t>(d.type));
+        if (d.type == ResourceType::Buffer) {
+            PutVar(d.byteSize);
+            PutVar(d.stride);
+            PutVar(static_cast<uint64_t>(d.usage));
+        } else {
+            PutVar(d.width);
+            PutVar(d.height);
+            PutVar(static_cast<uint64_t>(d.format));
+            PutVar(d.dynamicResolution ? 1 : 0);
+        }
+    }
+};
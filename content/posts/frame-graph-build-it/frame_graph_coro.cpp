@@ -0,0 +1,196 @@
+#include "frame_graph_coro.h"
+#include "frame_graph_trace.h"
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <set>
+
+// == AsyncRunQueue =============================================
+
+void AsyncRunQueue::Push(std::coroutine_handle<> h) {
+    // Notify under the lock: once the last pass finishes, the executor
+    // may return and destroy this queue the moment the lock is released.
+    std::lock_guard<std::mutex> guard(lock);
+    ready.push_back(h);
+    wake.notify_one();
+}
+
+bool AsyncRunQueue::Pop(std::coroutine_handle<>& h) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (ready.empty()) return false;
+    h = ready.front();
+    ready.pop_front();
+    return true;
+}
+
+void AsyncRunQueue::WaitFor(std::chrono::microseconds timeout) {
+    std::unique_lock<std::mutex> guard(lock);
+    wake.wait_for(guard, timeout, [&] { return !ready.empty(); });
+}
+
+// == GraphEvent ================================================
+
+bool GraphEvent::AddWaiter(std::coroutine_handle<> h, AsyncRunQueue* queue) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (signaled.load(std::memory_order_relaxed)) return false;   // don't suspend
+    waiters.push_back({ h, queue });
+    return true;
+}
+
+void GraphEvent::Signal() {
+    std::vector<Waiter> woken;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        signaled.store(true, std::memory_order_release);
+        woken.swap(waiters);
+    }
+    for (auto& w : woken) w.queue->Push(w.handle);
+}
+
+void GraphEvent::Reset() {
+    std::lock_guard<std::mutex> guard(lock);
+    signaled.store(false, std::memory_order_relaxed);
+}
+
+// == FrameGraph::Execute with coroutine passes =================
+// A pass becomes startable once every producer has *finished* recording
+// (a suspended producer holds its consumers back). Startable passes run
+// in sorted order; suspended coroutines are resumed as their events fire,
+// and outstanding fences are polled whenever the loop would otherwise
+// go idle. Recording order is not submission order, so barriers are
+// resolved up front in sorted order and replayed as each pass records.
+// Every resumption is timed like a plain pass (tracer slice, capture
+// timing), with the pass's barriers on its first slice.
+
+void FrameGraph::Execute(const CompiledPlan& plan, AsyncPassTable& async) {
+    Log("[6] Executing (coroutine passes may suspend):\n");
+    const BarrierSchedule schedule = PlanBarriers(plan);
+
+    const uint32_t n = static_cast<uint32_t>(passes.size());
+    std::vector<uint32_t> position(n), pending(n);
+    for (uint32_t i = 0; i < plan.sorted.size(); i++) position[plan.sorted[i]] = i;
+
+    std::set<uint32_t> startable;   // sorted positions, lowest first
+    uint32_t aliveCount = 0, finished = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        pending[i] = passes[i].inDegree;
+        if (!passes[i].alive) continue;
+        aliveCount++;
+        if (pending[i] == 0) startable.insert(position[i]);
+    }
+    for (uint32_t idx : plan.sorted) {
+        if (!passes[idx].alive)
+            Log("  -- skip: %s (CULLED)\n", passes[idx].name.c_str());
+    }
+
+    AsyncRunQueue runQueue;
+    std::vector<FenceWait> fences;
+    std::unique_ptr<GraphEvent[]> recorded(new GraphEvent[n]);
+    std::vector<PassContext> contexts(n);
+    std::vector<PassTask> tasks(n);
+    std::vector<uint32_t> barrierCount(n);   // reported with a pass's first slice
+    std::vector<uint8_t>  suspended(n);
+
+    // Culled passes never run; anyone waiting on one goes straight on.
+    for (uint32_t i = 0; i < n; i++)
+        if (!passes[i].alive) recorded[i].Signal();
+
+    auto Finish = [&](uint32_t idx) {
+        finished++;
+        recorded[idx].Signal();
+        for (uint32_t succ : passes[idx].successors) {
+            if (passes[succ].alive && --pending[succ] == 0)
+                startable.insert(position[succ]);
+        }
+    };
+
+    auto Resume = [&](PassTask::Handle h) {
+        uint32_t idx = h.promise().passIdx;
+        contexts[idx].waitingOn = UINT32_MAX;
+        suspended[idx] = 0;
+        if (tracer || capture) {
+            uint64_t begin = FrameTracer::NowNs();
+            h.resume();
+            RecordPassTime(idx, begin, FrameTracer::NowNs(), barrierCount[idx]);
+            barrierCount[idx] = 0;
+        } else {
+            h.resume();
+        }
+        if (h.done()) {
+            Log("  << done:    %s\n", passes[idx].name.c_str());
+            Finish(idx);
+        } else {
+            Log("  >> suspend: %s\n", passes[idx].name.c_str());
+            suspended[idx] = 1;
+        }
+    };
+
+    // Nothing startable, queued or polled, and every suspended pass waits
+    // on another pass: no event from outside can break the cycle.
+    auto Deadlocked = [&]() {
+        if (!fences.empty()) return false;
+        for (uint32_t i = 0; i < n; i++)
+            if (suspended[i] && contexts[i].waitingOn == UINT32_MAX) return false;
+        return true;
+    };
+
+    while (finished < aliveCount) {
+        while (!startable.empty()) {
+            uint32_t idx = plan.sorted[*startable.begin()];
+            startable.erase(startable.begin());
+
+            if (const AsyncPassTable::Body* body = async.Find(idx)) {
+                barrierCount[idx] = EmitBarriers(schedule, idx);
+                contexts[idx].passIdx  = idx;
+                contexts[idx].queue    = &runQueue;
+                contexts[idx].recorded = recorded.get();
+                contexts[idx].fences   = &fences;
+                tasks[idx] = (*body)(contexts[idx]);
+                tasks[idx].handle.promise().passIdx = idx;
+                Resume(tasks[idx].handle);
+            } else if (tracer || capture) {
+                ExecutePassTraced(idx, &schedule);
+                Finish(idx);
+            } else {
+                EmitBarriers(schedule, idx);
+                passes[idx].Execute(/* &cmdList */);
+                Finish(idx);
+            }
+        }
+
+        std::coroutine_handle<> h;
+        bool resumed = false;
+        while (runQueue.Pop(h)) {
+            Resume(PassTask::Handle::from_address(h.address()));
+            resumed = true;
+        }
+
+        for (size_t i = 0; i < fences.size();) {
+            if (fences[i].isComplete()) {
+                runQueue.Push(fences[i].handle);
+                fences[i] = std::move(fences.back());
+                fences.pop_back();
+                resumed = true;
+            } else {
+                i++;
+            }
+        }
+
+        if (resumed || !startable.empty() || finished == aliveCount) continue;
+        if (Deadlocked()) {
+            fprintf(stderr, "Execute: coroutine passes wait on each other and can never finish:\n");
+            for (uint32_t i = 0; i < n; i++) {
+                if (!suspended[i]) continue;
+                fprintf(stderr, "  %s waits for %s\n", passes[i].name.c_str(),
+                        passes[contexts[i].waitingOn].name.c_str());
+            }
+            assert(false && "coroutine pass deadlock");
+            break;   // abandon the frame; the suspended tasks are destroyed
+        }
+        // Nothing to do until an event fires or a fence completes.
+        runQueue.WaitFor(fences.empty() ? std::chrono::microseconds(10000)
+                                        : async.fencePollInterval);
+    }
+
+    EndFrame();
+}
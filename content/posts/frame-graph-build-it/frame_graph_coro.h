@@ -0,0 +1,196 @@
+#pragma once
+// Frame Graph — coroutine passes that suspend on graph events
+// A pass body may be a C++20 coroutine that co_awaits an upload, a fence
+// or another pass. While it is suspended the executor keeps recording
+// every other pass whose dependencies are met, and resumes the coroutine
+// once its event fires — latency we used to eat synchronously.
+//
+// Usage:
+//   AsyncPassTable async;
+//   AddAsyncPass(fg, async, "Terrain",
+//       [&]() { fg.Write(2, terrain); },
+//       [&](PassContext& ctx) -> PassTask {
+//           co_await ctx.Wait(uploadDone);   // suspends, others keep going
+//           /* record draws */
+//       });
+//   fg.Execute(fg.Compile(), async);
+//
+// Command lists still submit in sorted order; only recording reorders.
+// Passes that wait on each other in a cycle can never finish: Execute()
+// reports them on stderr, asserts, and abandons the frame.
+//
+// Compile: g++ -std=c++20 -pthread -o example_coro example_coro.cpp frame_graph_v3.cpp frame_graph_coro.cpp
+
+#include "frame_graph_v3.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// == Ready queue: coroutines the executor should resume ========
+// Events may fire on any thread; resumption always happens on the
+// thread running FrameGraph::Execute.
+class AsyncRunQueue {
+public:
+    void Push(std::coroutine_handle<> h);
+    bool Pop(std::coroutine_handle<>& h);
+    void WaitFor(std::chrono::microseconds timeout);
+
+private:
+    std::mutex                          lock;
+    std::condition_variable             wake;
+    std::deque<std::coroutine_handle<>> ready;
+};
+
+// == One-shot event: upload complete, readback done, ... ======
+class GraphEvent {
+public:
+    void Signal();   // thread-safe; queues every waiter for resumption
+    void Reset();    // re-arm for the next frame (no waiters allowed)
+    bool IsSignaled() const { return signaled.load(std::memory_order_acquire); }
+
+private:
+    friend class PassContext;
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        AsyncRunQueue*          queue;
+    };
+
+    std::mutex          lock;
+    std::atomic<bool>   signaled{false};
+    std::vector<Waiter> waiters;
+
+    bool AddWaiter(std::coroutine_handle<> h, AsyncRunQueue* queue);  // false if already signaled
+};
+
+// == Fence polled by the executor (no callback API needed) =====
+struct FenceWait {
+    std::function<bool()>   isComplete;
+    std::coroutine_handle<> handle;
+};
+
+// == Handed to each coroutine pass =============================
+class PassContext {
+public:
+    uint32_t PassIndex() const { return passIdx; }
+
+    auto Wait(GraphEvent& event) {
+        struct Awaiter {
+            GraphEvent&    event;
+            AsyncRunQueue* queue;
+            bool await_ready() const { return event.IsSignaled(); }
+            bool await_suspend(std::coroutine_handle<> h) { return event.AddWaiter(h, queue); }
+            void await_resume() const {}
+        };
+        return Awaiter{ event, queue };
+    }
+
+    // Another pass has finished recording (no resource edge required).
+    // A culled pass counts as finished.
+    auto WaitPass(uint32_t otherPass) {
+        struct Awaiter {
+            PassContext* ctx;
+            uint32_t     other;
+            bool await_ready() const { return ctx->recorded[other].IsSignaled(); }
+            bool await_suspend(std::coroutine_handle<> h) {
+                if (!ctx->recorded[other].AddWaiter(h, ctx->queue)) return false;
+                ctx->waitingOn = other;   // lets the executor spot a deadlock
+                return true;
+            }
+            void await_resume() const {}
+        };
+        return Awaiter{ this, otherPass };
+    }
+
+    // e.g. [&] { return fence->GetCompletedValue() >= value; }
+    auto WaitFence(std::function<bool()> isComplete) {
+        struct Awaiter {
+            std::function<bool()>   isComplete;
+            std::vector<FenceWait>* fences;
+            bool await_ready() const { return isComplete(); }
+            void await_suspend(std::coroutine_handle<> h) {
+                fences->push_back({ std::move(isComplete), h });
+            }
+            void await_resume() const {}
+        };
+        return Awaiter{ std::move(isComplete), fences };
+    }
+
+private:
+    friend class FrameGraph;
+    uint32_t                passIdx  = 0;
+    AsyncRunQueue*          queue    = nullptr;
+    GraphEvent*             recorded = nullptr;   // one event per pass
+    std::vector<FenceWait>* fences   = nullptr;
+    uint32_t                waitingOn = UINT32_MAX;   // pass this one is suspended on
+};
+
+// == Coroutine return type for pass bodies =====================
+// Starts suspended; the executor resumes it right after the pass's
+// barriers are emitted and destroys it once the frame finishes.
+class PassTask {
+public:
+    struct promise_type {
+        uint32_t passIdx = 0;
+        PassTask get_return_object() {
+            return PassTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    PassTask() = default;
+    explicit PassTask(Handle h) : handle(h) {}
+    PassTask(PassTask&& other) noexcept : handle(other.handle) { other.handle = {}; }
+    PassTask& operator=(PassTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = other.handle;
+            other.handle = {};
+        }
+        return *this;
+    }
+    PassTask(const PassTask&) = delete;
+    PassTask& operator=(const PassTask&) = delete;
+    ~PassTask() { if (handle) handle.destroy(); }
+
+    Handle handle;
+};
+
+// == Coroutine bodies, by pass index ===========================
+class AsyncPassTable {
+public:
+    using Body = std::function<PassTask(PassContext&)>;
+
+    void Set(uint32_t passIdx, Body body) {
+        if (passIdx >= bodies.size()) bodies.resize(passIdx + 1);
+        bodies[passIdx] = std::move(body);
+    }
+    const Body* Find(uint32_t passIdx) const {
+        return passIdx < bodies.size() && bodies[passIdx] ? &bodies[passIdx] : nullptr;
+    }
+
+    // How often outstanding fences are polled while nothing else can run.
+    std::chrono::microseconds fencePollInterval{50};
+
+private:
+    std::vector<Body> bodies;
+};
+
+// Registers a pass whose body is a coroutine. Under the plain Execute()
+// the pass is a no-op; run the graph with Execute(plan, table).
+template <typename SetupFn, typename BodyFn>
+void AddAsyncPass(FrameGraph& fg, AsyncPassTable& table, const std::string& name,
+                  SetupFn&& setup, BodyFn&& body) {
+    table.Set(static_cast<uint32_t>(fg.Passes().size()), std::forward<BodyFn>(body));
+    fg.AddPass(name, std::forward<SetupFn>(setup), [](/*cmd*/) {});
+}
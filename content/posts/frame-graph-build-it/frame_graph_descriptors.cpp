@@ -0,0 +1,80 @@
+#include "frame_graph_descriptors.h"
+#include <algorithm>
+#include <cassert>
+
+// == Bindless descriptor slots =================================
+// Walk resources in lifetime order and look up one descriptor per
+// (allocation, view shape). Resources that alias a block with the same
+// shape share the slot; an unchanged frame hits last frame's slots and
+// creates nothing.
+
+void DescriptorCache::OnCompiled(const FrameGraph& fg, const FrameGraph::CompiledPlan& plan) {
+    if (plan.overBudget) return;   // the pool committed nothing for it
+    assert(pool.BlockCount() >= plan.blocks.size()
+           && "attach the HeapPool before the DescriptorCache");
+
+    const auto& entries = fg.Entries();
+    planSlots.assign(entries.size(), UINT32_MAX);
+
+    std::vector<uint32_t> order;
+    for (uint32_t r = 0; r < plan.mapping.size(); r++)
+        if (plan.mapping[r] != UINT32_MAX) order.push_back(r);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return plan.lifetimes[a].firstUse < plan.lifetimes[b].firstUse;
+    });
+
+    for (uint32_t r : order) {
+        const ResourceDesc& d = entries[r].desc;
+        DescriptorKey key;
+        key.allocation = pool.Generation(plan.mapping[r]);
+        key.type       = d.type;
+        if (d.type == ResourceType::Buffer) {
+            key.byteSize = d.byteSize;
+            key.stride   = d.stride;
+        } else {
+            key.format = d.format;
+            key.width  = d.width;
+            key.height = d.height;
+        }
+        planSlots[r] = Acquire(key, fg.FrameIndex());
+    }
+}
+
+uint32_t DescriptorCache::Acquire(const DescriptorKey& key, uint64_t frame) {
+    auto it = lookup.find(key);
+    if (it != lookup.end()) {
+        slots[it->second].lastUsedFrame = frame;
+        stats.reusedThisFrame++;
+        stats.reusedTotal++;
+        return it->second;
+    }
+
+    uint32_t idx;
+    if (!freeSlots.empty()) {
+        idx = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        idx = static_cast<uint32_t>(slots.size());
+        slots.push_back({});
+    }
+    slots[idx] = { key, frame, true };
+    lookup[key] = idx;
+    stats.createdThisFrame++;
+    stats.createdTotal++;
+    stats.highWater = std::max(stats.highWater, static_cast<uint32_t>(slots.size() - freeSlots.size()));
+    return idx;
+}
+
+void DescriptorCache::OnEndFrame(const FrameGraph& fg) {
+    uint64_t nextFrame = fg.FrameIndex() + 1;
+    for (uint32_t i = 0; i < slots.size(); i++) {
+        SlotEntry& slot = slots[i];
+        // Unused for kFramesInFlight frames: no GPU work can reference it.
+        if (!slot.inUse || slot.lastUsedFrame + kFramesInFlight > nextFrame) continue;
+        lookup.erase(slot.key);
+        slot.inUse = false;
+        freeSlots.push_back(i);
+    }
+    stats.createdThisFrame = 0;
+    stats.reusedThisFrame  = 0;
+}
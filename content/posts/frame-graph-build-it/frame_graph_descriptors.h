@@ -0,0 +1,87 @@
+#pragma once
+// Frame Graph — aliasing-aware bindless descriptor slots
+// Every aliased resource gets a slot in the bindless descriptor heap. A
+// descriptor is the allocation it points into plus the shape it views
+// it as, so resources that alias a block with the same shape share a
+// slot, and a frame whose blocks were not reallocated finds last
+// frame's slots still valid and creates nothing. Slots are assigned
+// after the HeapPool commits the plan (attach the pool first); an
+// over-budget plan gets none.
+//
+// A slot is freed once no frame has used it for kFramesInFlight frames,
+// not when its resource's lifetime ends: shaders read the heap when the
+// GPU executes, so a slot can't be rewritten for another resource while
+// its frame may still be in flight.
+//
+// Usage:
+//   HeapPool        pool;
+//   DescriptorCache descriptors(pool);
+//   fg.AddHook(&pool);
+//   fg.AddHook(&descriptors);
+//   ... in a pass: uint32_t idx = descriptors.Slot(hdr);
+//
+// Compile: g++ -std=c++17 -o example_descriptors example_descriptors.cpp frame_graph_v3.cpp frame_graph_pool.cpp frame_graph_descriptors.cpp
+
+#include "frame_graph_pool.h"
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+struct DescriptorKey {
+    uint64_t     allocation = 0;   // HeapPool::Generation() of the block
+    ResourceType type       = ResourceType::Texture;
+    Format       format     = Format::RGBA8;
+    uint32_t     width      = 0;
+    uint32_t     height     = 0;
+    uint64_t     byteSize   = 0;
+    uint32_t     stride     = 0;
+
+    bool operator<(const DescriptorKey& o) const {
+        return std::tie(allocation, type, format, width, height, byteSize, stride)
+             < std::tie(o.allocation, o.type, o.format, o.width, o.height,
+                        o.byteSize, o.stride);
+    }
+};
+
+struct DescriptorStats {
+    uint32_t createdThisFrame = 0;   // slots (re)written this frame
+    uint32_t reusedThisFrame  = 0;   // lookups served by an existing slot
+    uint64_t createdTotal     = 0;
+    uint64_t reusedTotal      = 0;
+    uint32_t highWater        = 0;   // most slots ever allocated at once
+
+    double ReuseRate() const {
+        uint64_t lookups = createdTotal + reusedTotal;
+        return lookups ? static_cast<double>(reusedTotal) / lookups : 0.0;
+    }
+};
+
+class DescriptorCache : public FrameGraphHook {
+public:
+    explicit DescriptorCache(const HeapPool& pool) : pool(pool) {}
+
+    void OnCompiled(const FrameGraph& fg, const FrameGraph::CompiledPlan& plan) override;
+    void OnEndFrame(const FrameGraph& fg) override;   // frees slots unused for kFramesInFlight
+
+    // Bindless slot of `h` in the latest committed plan; UINT32_MAX if
+    // it was culled or imported.
+    uint32_t Slot(ResourceHandle h) const { return planSlots[h.index]; }
+
+    const DescriptorStats& Stats() const { return stats; }
+
+private:
+    struct SlotEntry {
+        DescriptorKey key;
+        uint64_t      lastUsedFrame = 0;
+        bool          inUse         = false;
+    };
+    const HeapPool&                   pool;
+    std::vector<SlotEntry>            slots;
+    std::vector<uint32_t>             freeSlots;
+    std::map<DescriptorKey, uint32_t> lookup;
+    std::vector<uint32_t>             planSlots;   // per virtual resource
+    DescriptorStats                   stats;
+
+    uint32_t Acquire(const DescriptorKey& key, uint64_t frame);   // creates on a miss
+};
@@ -0,0 +1,64 @@
+#include "frame_graph_pool.h"
+#include <algorithm>
+
+// == Dynamic resolution ========================================
+
+Extent ActiveExtent(const FrameGraph& fg, ResourceHandle h) {
+    const ResourceDesc& d = fg.Entries()[h.index].desc;
+    if (!d.dynamicResolution) return { d.width, d.height };
+    float scale = fg.ResolutionScale();
+    auto Scale = [&](uint32_t full) {
+        uint32_t v = static_cast<uint32_t>(full * scale + 0.5f);
+        return std::min(std::max(v, 1u), full);
+    };
+    return { Scale(d.width), Scale(d.height) };
+}
+
+// == Persistent heap pool ======================================
+
+void HeapPool::OnCompiled(const FrameGraph& fg, const FrameGraph::CompiledPlan& plan) {
+    // An over-budget plan is a diagnostic, not something to run: don't
+    // grow the resident pool for it.
+    if (plan.overBudget) return;
+
+    stats.allocationsFrame = 0;
+    for (uint32_t i = 0; i < plan.blocks.size(); i++) {
+        const PhysicalBlock& want = plan.blocks[i];
+        if (i == resident.size()) {
+            resident.push_back(want);
+            generation.push_back(0);
+        } else {
+            PhysicalBlock& have = resident[i];
+            bool fits = have.sizeBytes >= want.sizeBytes
+                     && have.alignment >= want.alignment
+                     && CanShareHeap(fg.Tier(), have.heapType, want.heapType);
+            if (fits) continue;
+            // The GPU may still be reading the old allocation.
+            retiring.push_back({ have.sizeBytes, fg.FrameIndex() });
+            stats.retiringBytes += have.sizeBytes;
+            have.sizeBytes = std::max(have.sizeBytes, want.sizeBytes);
+            have.alignment = std::max(have.alignment, want.alignment);
+            have.heapType  = want.heapType;
+        }
+        generation[i] = nextGeneration++;
+        stats.allocationsFrame++;
+    }
+    stats.allocations += stats.allocationsFrame;
+    stats.residentBytes = 0;
+    for (auto& blk : resident) stats.residentBytes += blk.sizeBytes;
+}
+
+void HeapPool::OnEndFrame(const FrameGraph& fg) {
+    // Same rule as descriptor slots: untouched for kFramesInFlight frames.
+    uint64_t nextFrame = fg.FrameIndex() + 1;
+    for (uint32_t i = 0; i < retiring.size();) {
+        if (retiring[i].frame + kFramesInFlight <= nextFrame) {
+            stats.retiringBytes -= retiring[i].sizeBytes;
+            stats.freed++;
+            retiring[i] = retiring.back();
+            retiring.pop_back();
+        } else {
+            i++;
+        }
+    }
+}
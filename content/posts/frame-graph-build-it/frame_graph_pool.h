@@ -0,0 +1,79 @@
+#pragma once
+// Frame Graph — persistent heap pool and dynamic resolution
+// Physical blocks outlive the frame: each compiled plan's blocks are
+// matched by index against what is already resident and only created or
+// grown when they don't fit. A stable graph stops allocating after its
+// first frame. A block that has to grow gets a fresh allocation; frames
+// still in flight may be reading the old one, so it goes on a retire
+// list and is freed kFramesInFlight frames later.
+//
+// Dynamic-resolution targets are declared at their maximum size, so the
+// pool (and aliasing) only ever sees that size; passes render into
+// ActiveExtent() at the graph's current resolution scale, and a new
+// scale reallocates nothing.
+//
+// Usage:
+//   HeapPool pool;
+//   fg.AddHook(&pool);
+//   auto hdr = fg.CreateResource(DynamicDesc(1920, 1080, Format::RGBA16F));
+//   fg.SetResolutionScale(0.75f);              // per frame
+//   ... in a pass: Extent e = ActiveExtent(fg, hdr);
+//
+// Compile: g++ -std=c++17 -O2 -o example_dynres example_dynres.cpp frame_graph_v3.cpp frame_graph_pool.cpp
+
+#include "frame_graph_v3.h"
+#include <cstdint>
+#include <vector>
+
+// == Dynamic resolution ========================================
+constexpr ResourceDesc DynamicDesc(uint32_t maxWidth, uint32_t maxHeight, Format format) {
+    ResourceDesc d;
+    d.width             = maxWidth;
+    d.height            = maxHeight;
+    d.format            = format;
+    d.dynamicResolution = true;
+    return d;
+}
+
+struct Extent {
+    uint32_t width  = 0;
+    uint32_t height = 0;
+};
+
+// `h`'s declared size, scaled by fg.ResolutionScale() if it is a
+// dynamic-resolution target. Valid while the frame's passes execute.
+Extent ActiveExtent(const FrameGraph& fg, ResourceHandle h);
+
+// == Persistent heap pool ======================================
+struct MemoryPoolStats {
+    uint32_t allocations      = 0;   // blocks created or grown, all frames
+    uint32_t allocationsFrame = 0;   // ... by the latest compile
+    uint64_t residentBytes    = 0;
+    uint64_t retiringBytes    = 0;   // replaced, waiting out frames in flight
+    uint32_t freed            = 0;   // replaced allocations released, all frames
+};
+
+class HeapPool : public FrameGraphHook {
+public:
+    void OnCompiled(const FrameGraph& fg, const FrameGraph::CompiledPlan& plan) override;
+    void OnEndFrame(const FrameGraph& fg) override;   // frees retired allocations
+
+    // Identity of the allocation behind `block`: new every time the
+    // block is created or grown, never reused. Anything created against
+    // an allocation (descriptors, views) keys on this, not on the index.
+    uint64_t Generation(uint32_t block) const { return generation[block]; }
+    uint32_t BlockCount() const { return static_cast<uint32_t>(resident.size()); }
+
+    const MemoryPoolStats& Stats() const { return stats; }
+
+private:
+    struct Retired {
+        uint64_t sizeBytes = 0;
+        uint64_t frame     = 0;   // frame whose compile replaced it
+    };
+    std::vector<PhysicalBlock> resident;
+    std::vector<uint64_t>      generation;   // per resident block
+    std::vector<Retired>       retiring;
+    uint64_t                   nextGeneration = 0;
+    MemoryPoolStats            stats;
+};
@@ -0,0 +1,59 @@
+#pragma once
+// Frame Graph — CPU-side GPU timeline simulator
+// An alternate executor for a CompiledPlan: instead of recording commands
+// it replays the plan against per-pass and per-transition cost estimates
+// on one or more simulated queues. Use it as the regression harness for
+// TopoSort / InsertBarriers / AliasResources changes — no GPU required.
+//
+// Call between Compile() and Execute(); the graph is left untouched.
+//
+// Compile: g++ -std=c++17 -o example_sim example_sim.cpp frame_graph_v3.cpp frame_graph_sim.cpp
+
+#include "frame_graph_v3.h"
+#include <cstdint>
+#include <vector>
+
+// == Cost model ================================================
+struct SimCosts {
+    std::vector<double>   passUs;          // per pass index (missing → default)
+    std::vector<uint32_t> passQueue;       // per pass index (missing → queue 0)
+    double   defaultPassUs     = 100.0;
+    double   barrierUs         = 2.0;      // per state transition
+    double   crossQueueFenceUs = 15.0;     // signal + wait between queues
+    uint32_t queueCount        = 1;
+};
+
+// == Results ===================================================
+struct SimPassTiming {
+    uint32_t pass     = 0;
+    uint32_t queue    = 0;
+    uint32_t barriers = 0;
+    double   startUs  = 0;    // barriers start here...
+    double   endUs    = 0;    // ...and the pass body ends here
+};
+
+struct SimQueueStats {
+    double   busyUs    = 0;   // pass bodies
+    double   barrierUs = 0;   // stalls on transitions
+    double   idleUs    = 0;   // bubbles, including the tail to frame end
+    uint32_t barriers  = 0;
+};
+
+struct SimReport {
+    double   frameUs          = 0;
+    double   idleUs           = 0;   // summed over queues
+    double   barrierStallUs   = 0;   // summed over queues
+    uint32_t barrierCount     = 0;
+    uint64_t memoryHighWater  = 0;   // peak bytes of blocks holding live data
+    uint64_t memoryReserved   = 0;   // all physical blocks
+    uint32_t aliasHazards     = 0;   // aliased resources overlapping in time
+
+    std::vector<SimQueueStats> queues;
+    std::vector<SimPassTiming> timeline;   // in simulated issue order
+
+    void Print(const FrameGraph& fg) const;
+};
+
+SimReport SimulateTimeline(const FrameGraph& fg,
+                           const FrameGraph::CompiledPlan& plan,
+                           const SimCosts& costs);
@@ -0,0 +1,234 @@
+#pragma once
+// Frame Graph — static graphs compiled by the C++ compiler
+// For pipelines that never change shape (the "Static" strategy), the
+// whole runtime compile is repeated work. Here passes and accesses are
+// constexpr data; CompileStatic() runs the same steps as
+// FrameGraph::Compile — versioned edges, Kahn sort, culling, lifetimes,
+// first-fit aliasing, barriers — during constant evaluation, and
+// ExecuteStatic() unrolls the sorted order into straight-line calls.
+//
+// Usage:
+//   constexpr StaticGraph<2, 2, 3> kGraph = {{{
+//       { {1920, 1080, Format::D32F} },
+//       { {1920, 1080, Format::RGBA8}, true, ResourceState::Present } }},
+//     {{ "Depth", "Present" }},
+//     {{ WriteOf(0, 0), ReadOf(1, 0), WriteOf(1, 1) }} };
+//   static constexpr auto kPlan = CompileStatic(kGraph);
+//   ExecuteStatic<kPlan>(std::make_tuple(depthFn, presentFn), onBarrier);
+//
+// List accesses in the order the passes' Setup would call Read/Write, so
+// versioning matches the runtime graph. Header-only.
+//
+// Compile: g++ -std=c++17 -O2 -o example_static example_static.cpp frame_graph_v3.cpp
+
+#include "frame_graph_v3.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// == Compile-time declarations =================================
+struct StaticResource {
+    ResourceDesc  desc;
+    bool          imported     = false;
+    ResourceState initialState = ResourceState::Undefined;
+};
+
+struct StaticAccess {
+    uint32_t pass     = 0;
+    uint32_t resource = 0;
+    bool     write    = false;
+};
+
+constexpr StaticAccess ReadOf(uint32_t pass, uint32_t resource)  { return { pass, resource, false }; }
+constexpr StaticAccess WriteOf(uint32_t pass, uint32_t resource) { return { pass, resource, true }; }
+
+template <size_t R, size_t P, size_t A>
+struct StaticGraph {
+    std::array<StaticResource, R> resources;
+    std::array<const char*, P>    passNames;
+    std::array<StaticAccess, A>   accesses;   // grouped by pass, in pass order
+};
+
+// == Compile-time plan =========================================
+struct StaticBarrier {
+    uint32_t      resource = 0;
+    ResourceState before   = ResourceState::Undefined;
+    ResourceState after    = ResourceState::Undefined;
+};
+
+template <size_t R, size_t P, size_t A>
+struct StaticPlan {
+    static constexpr size_t kResources = R;
+    static constexpr size_t kPasses    = P;
+
+    std::array<uint32_t, P>      sorted{};
+    std::array<bool, P>          alive{};
+    std::array<Lifetime, R>      lifetimes{};   // in sorted positions, like ScanLifetimes
+    std::array<uint32_t, R>      mapping{};     // UINT32_MAX = not aliased
+    std::array<PhysicalBlock, R> blocks{};      // first blockCount are used
+    uint32_t                     blockCount  = 0;
+    uint64_t                     memoryBytes = 0;
+
+    // Barriers in execution order; sorted[k] emits barriers[barrierBegin[k]
+    // .. barrierBegin[k + 1]) right before it runs.
+    std::array<StaticBarrier, A> barriers{};
+    std::array<uint32_t, P + 1>  barrierBegin{};
+    uint32_t                     barrierCount = 0;
+};
+
+// Reached only for a malformed graph; during constant evaluation the call
+// to a non-constexpr function is the compile error.
+inline void StaticGraphError(const char* why) {
+    (void)why;
+    assert(false && "invalid static frame graph");
+}
+
+// == CompileStatic: FrameGraph::Compile as a constant expression ==
+template <size_t R, size_t P, size_t A>
+constexpr StaticPlan<R, P, A> CompileStatic(const StaticGraph<R, P, A>& g,
+                                            HeapTier tier = HeapTier::Tier2) {
+    StaticPlan<R, P, A> plan{};
+
+    // [1] Edges: a read depends on the resource's latest writer so far.
+    std::array<std::array<bool, P>, P> dependsOn{};   // [pass][producer]
+    std::array<uint32_t, R> lastWriter{};
+    for (auto& w : lastWriter) w = UINT32_MAX;
+    for (size_t i = 0; i < A; i++) {
+        const StaticAccess& a = g.accesses[i];
+        if (a.pass >= P || a.resource >= R) StaticGraphError("access out of range");
+        if (i > 0 && a.pass < g.accesses[i - 1].pass) StaticGraphError("accesses out of pass order");
+        if (a.write) {
+            lastWriter[a.resource] = a.pass;
+        } else if (lastWriter[a.resource] != UINT32_MAX) {
+            dependsOn[a.pass][lastWriter[a.resource]] = true;
+        }
+    }
+
+    // [2] Kahn, FIFO; successors in ascending pass order like BuildEdges.
+    std::array<uint32_t, P> inDeg{};
+    for (size_t p = 0; p < P; p++)
+        for (size_t d = 0; d < P; d++)
+            if (dependsOn[p][d]) inDeg[p]++;
+    std::array<uint32_t, P> queue{};
+    size_t head = 0, tail = 0, count = 0;
+    for (size_t p = 0; p < P; p++)
+        if (inDeg[p] == 0) queue[tail++] = static_cast<uint32_t>(p);
+    while (head < tail) {
+        uint32_t cur = queue[head++];
+        plan.sorted[count++] = cur;
+        for (size_t succ = 0; succ < P; succ++)
+            if (dependsOn[succ][cur] && --inDeg[succ] == 0)
+                queue[tail++] = static_cast<uint32_t>(succ);
+    }
+    if (count != P) StaticGraphError("cycle detected");
+
+    // [3] Cull: the last sorted pass is the output; keep what feeds it.
+    if (P > 0) plan.alive[plan.sorted[P - 1]] = true;
+    for (size_t k = P; k-- > 0;) {
+        uint32_t p = plan.sorted[k];
+        if (!plan.alive[p]) continue;
+        for (size_t d = 0; d < P; d++)
+            if (dependsOn[p][d]) plan.alive[d] = true;
+    }
+
+    // [4] Lifetimes over sorted positions of live passes.
+    std::array<uint32_t, P> position{};
+    for (size_t k = 0; k < P; k++) position[plan.sorted[k]] = static_cast<uint32_t>(k);
+    for (size_t r = 0; r < R; r++) plan.lifetimes[r].isTransient = !g.resources[r].imported;
+    for (const StaticAccess& a : g.accesses) {
+        if (!plan.alive[a.pass]) continue;
+        Lifetime& lt = plan.lifetimes[a.resource];
+        uint32_t k = position[a.pass];
+        if (k < lt.firstUse) lt.firstUse = k;
+        if (k > lt.lastUse)  lt.lastUse  = k;
+    }
+
+    // [5] First-fit aliasing in (stable) firstUse order.
+    std::array<uint32_t, R> byFirstUse{};
+    for (size_t r = 0; r < R; r++) {
+        size_t j = r;   // insertion sort: stable, constexpr-friendly
+        while (j > 0 && plan.lifetimes[byFirstUse[j - 1]].firstUse > plan.lifetimes[r].firstUse) {
+            byFirstUse[j] = byFirstUse[j - 1];
+            j--;
+        }
+        byFirstUse[j] = static_cast<uint32_t>(r);
+    }
+    for (auto& m : plan.mapping) m = UINT32_MAX;
+    for (uint32_t r : byFirstUse) {
+        const Lifetime& lt = plan.lifetimes[r];
+        if (!lt.isTransient || lt.firstUse == UINT32_MAX) continue;
+        const ResourceDesc& desc = g.resources[r].desc;
+        Footprint needed = ResourceFootprint(desc);
+
+        uint32_t found = UINT32_MAX;
+        for (uint32_t b = 0; b < plan.blockCount; b++) {
+            const PhysicalBlock& blk = plan.blocks[b];
+            if (blk.availAfter < lt.firstUse && blk.sizeBytes >= needed.sizeBytes
+                && blk.alignment >= needed.alignment
+                && CanShareHeap(tier, blk.heapType, desc.type)) {
+                found = b;
+                break;
+            }
+        }
+        if (found == UINT32_MAX) {
+            found = plan.blockCount++;
+            plan.blocks[found] = { needed.sizeBytes, needed.alignment, lt.lastUse, desc.type };
+        }
+        plan.blocks[found].availAfter = lt.lastUse;
+        plan.mapping[r] = found;
+    }
+    for (uint32_t b = 0; b < plan.blockCount; b++) plan.memoryBytes += plan.blocks[b].sizeBytes;
+
+    // [6] Barriers: reads then writes per pass, same rule as InsertBarriers.
+    std::array<ResourceState, R> state{};
+    for (size_t r = 0; r < R; r++) state[r] = g.resources[r].initialState;
+    for (size_t k = 0; k < P; k++) {
+        uint32_t p = plan.sorted[k];
+        plan.barrierBegin[k] = plan.barrierCount;
+        if (!plan.alive[p]) continue;
+        for (int phase = 0; phase < 2; phase++) {
+            bool writes = phase == 1;
+            for (const StaticAccess& a : g.accesses) {
+                if (a.pass != p || a.write != writes) continue;
+                ResourceState needed = StateForAccess(g.resources[a.resource].desc, a.write);
+                if (state[a.resource] == needed) continue;
+                plan.barriers[plan.barrierCount++] = { a.resource, state[a.resource], needed };
+                state[a.resource] = needed;
+            }
+        }
+    }
+    plan.barrierBegin[P] = plan.barrierCount;
+    return plan;
+}
+
+// == ExecuteStatic: the sorted order, unrolled =================
+// `passFns` is a tuple of callables indexed by pass; culled passes are
+// never instantiated into the call sequence. `onBarrier` receives each
+// StaticBarrier right before the pass that needs it.
+
+template <const auto& Plan, size_t K, typename PassFns, typename OnBarrier>
+inline void ExecuteStaticStep(PassFns& passFns, OnBarrier& onBarrier) {
+    constexpr uint32_t pass = Plan.sorted[K];
+    if constexpr (Plan.alive[pass]) {
+        for (uint32_t b = Plan.barrierBegin[K]; b < Plan.barrierBegin[K + 1]; b++)
+            onBarrier(Plan.barriers[b]);
+        std::get<pass>(passFns)();
+    }
+}
+
+template <const auto& Plan, typename PassFns, typename OnBarrier, size_t... K>
+inline void ExecuteStaticImpl(PassFns& passFns, OnBarrier& onBarrier,
+                              std::index_sequence<K...>) {
+    (ExecuteStaticStep<Plan, K>(passFns, onBarrier), ...);
+}
+
+template <const auto& Plan, typename PassFns, typename OnBarrier>
+inline void ExecuteStatic(PassFns&& passFns, OnBarrier&& onBarrier) {
+    constexpr size_t passCount = std::remove_reference_t<decltype(Plan)>::kPasses;
+    static_assert(std::tuple_size<std::remove_reference_t<PassFns>>::value == passCount,
+                  "one callable per pass");
+    ExecuteStaticImpl<Plan>(passFns, onBarrier, std::make_index_sequence<passCount>{});
+}
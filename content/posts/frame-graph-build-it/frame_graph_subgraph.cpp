@@ -0,0 +1,330 @@
+#include "frame_graph_subgraph.h"
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+// == SubgraphTemplate ==========================================
+
+SubgraphSlot SubgraphTemplate::Transient(const ResourceDesc& prototype) {
+    slots.push_back({ false, prototype });
+    return { static_cast<uint32_t>(slots.size() - 1) };
+}
+
+SubgraphSlot SubgraphTemplate::External() {
+    slots.push_back({ true, {} });
+    return { static_cast<uint32_t>(slots.size() - 1) };
+}
+
+// Same versioning as FrameGraph::Read/Write, but over template slots and
+// only for writers inside the template. Accesses to external slots that
+// precede any local writer are resolved per instance.
+void SubgraphTemplate::Read(uint32_t localPass, SubgraphSlot slot) {
+    uint32_t writer = slots[slot.index].lastWriter;
+    if (writer != UINT32_MAX) passes[localPass].dependsOn.push_back(writer);
+    passes[localPass].reads.push_back(slot.index);
+}
+
+void SubgraphTemplate::Write(uint32_t localPass, SubgraphSlot slot) {
+    slots[slot.index].lastWriter = localPass;
+    passes[localPass].writes.push_back(slot.index);
+}
+
+void SubgraphTemplate::Compile() {
+    uint32_t n = static_cast<uint32_t>(passes.size());
+
+    // Dedup once here so BuildEdges can trust every instance's list.
+    std::vector<uint32_t> inDeg(n, 0);
+    std::vector<std::vector<uint32_t>> successors(n);
+    for (uint32_t i = 0; i < n; i++) {
+        auto& deps = passes[i].dependsOn;
+        std::sort(deps.begin(), deps.end());
+        deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+        for (uint32_t dep : deps) successors[dep].push_back(i);
+        inDeg[i] = static_cast<uint32_t>(deps.size());
+    }
+
+    // Kahn, FIFO — the order every instance is appended in.
+    order.clear();
+    std::queue<uint32_t> q;
+    for (uint32_t i = 0; i < n; i++)
+        if (inDeg[i] == 0) q.push(i);
+    while (!q.empty()) {
+        uint32_t cur = q.front(); q.pop();
+        order.push_back(cur);
+        for (uint32_t succ : successors[cur])
+            if (--inDeg[succ] == 0) q.push(succ);
+    }
+    assert(order.size() == n && "Cycle detected in subgraph template!");
+
+    orderPos.assign(n, 0);
+    for (uint32_t k = 0; k < n; k++) orderPos[order[k]] = k;
+
+    qualifiedNames.resize(n);
+    for (uint32_t i = 0; i < n; i++)
+        qualifiedNames[i] = name + "/" + passes[i].name;
+
+    SubgraphShape shape;
+    shape.external.resize(slots.size());
+    shape.descs.resize(slots.size());
+    for (uint32_t s = 0; s < slots.size(); s++) {
+        shape.external[s] = slots[s].external;
+        shape.descs[s]    = slots[s].prototype;
+    }
+    shape.passes.resize(n);
+    for (uint32_t k = 0; k < n; k++) {
+        const LocalPass& lp = passes[order[k]];
+        shape.passes[k].reads  = lp.reads;
+        shape.passes[k].writes = lp.writes;
+        for (uint32_t dep : lp.dependsOn) shape.passes[k].dependsOn.push_back(orderPos[dep]);
+    }
+    plan = std::make_shared<const SubgraphPlan>(PlanSubgraph(shape));
+
+    compiled = true;
+}
+
+// == Per-template plan =========================================
+// The same culling, lifetime scan, barrier walk and first-fit packing
+// the graph runs, done once over local positions. Transients only ever
+// see this instance's passes and start Undefined, so their part is the
+// same in every instance.
+
+SubgraphPlan PlanSubgraph(const SubgraphShape& shape) {
+    const uint32_t n     = static_cast<uint32_t>(shape.passes.size());
+    const uint32_t slots = static_cast<uint32_t>(shape.external.size());
+    SubgraphPlan plan;
+
+    // Live: writes an external slot, or feeds a live pass.
+    plan.alive.assign(n, 0);
+    for (uint32_t k = n; k-- > 0;) {
+        const auto& pass = shape.passes[k];
+        for (uint32_t s : pass.writes)
+            if (shape.external[s]) plan.alive[k] = 1;
+        if (!plan.alive[k]) continue;
+        for (uint32_t dep : pass.dependsOn) plan.alive[dep] = 1;
+    }
+
+    plan.slotLife.assign(slots, {});
+    std::vector<ResourceState> state(slots, ResourceState::Undefined);
+    plan.stepFirst.reserve(n + 1);
+    for (uint32_t k = 0; k < n; k++) {
+        plan.stepFirst.push_back(static_cast<uint32_t>(plan.steps.size()));
+        if (!plan.alive[k]) continue;
+        auto Access = [&](uint32_t s, bool isWrite) {
+            Lifetime& lt = plan.slotLife[s];
+            lt.firstUse = std::min(lt.firstUse, k);
+            lt.lastUse  = std::max(lt.lastUse,  k);
+            if (shape.external[s]) {
+                plan.steps.push_back({ s, true, isWrite });
+                return;
+            }
+            ResourceState needed = StateForAccess(shape.descs[s], isWrite);
+            if (state[s] == needed) return;
+            plan.steps.push_back({ s, false, isWrite, state[s], needed });
+            state[s] = needed;
+        };
+        for (uint32_t s : shape.passes[k].reads)  Access(s, false);
+        for (uint32_t s : shape.passes[k].writes) Access(s, true);
+    }
+    plan.stepFirst.push_back(static_cast<uint32_t>(plan.steps.size()));
+
+    // First fit by first use, as AliasResources does: a block takes
+    // same-type transients whose lifetimes do not overlap.
+    std::vector<uint32_t> transients;
+    for (uint32_t s = 0; s < slots; s++)
+        if (!shape.external[s] && plan.slotLife[s].firstUse != UINT32_MAX)
+            transients.push_back(s);
+    std::stable_sort(transients.begin(), transients.end(), [&](uint32_t a, uint32_t b) {
+        return plan.slotLife[a].firstUse < plan.slotLife[b].firstUse;
+    });
+    struct OpenBlock { Footprint size; ResourceType type; uint32_t availAfter; };
+    std::vector<OpenBlock> open;
+    for (uint32_t s : transients) {
+        Footprint need = ResourceFootprint(shape.descs[s]);
+        const Lifetime& lt = plan.slotLife[s];
+        uint32_t found = UINT32_MAX;
+        for (uint32_t b = 0; b < open.size(); b++) {
+            if (open[b].type == shape.descs[s].type && open[b].availAfter < lt.firstUse
+                && open[b].size.sizeBytes >= need.sizeBytes
+                && open[b].size.alignment >= need.alignment) {
+                found = b;
+                break;
+            }
+        }
+        if (found == UINT32_MAX) {
+            found = static_cast<uint32_t>(open.size());
+            open.push_back({ need, shape.descs[s].type, 0 });
+            plan.blocks.emplace_back();
+            plan.blockItems.push_back({ lt, need, shape.descs[s].type });
+        }
+        open[found].availAfter = lt.lastUse;
+        plan.blocks[found].push_back(s);
+
+        SubgraphPlan::BlockItem& item = plan.blockItems[found];
+        item.life.firstUse = std::min(item.life.firstUse, lt.firstUse);
+        item.life.lastUse  = std::max(item.life.lastUse,  lt.lastUse);
+        item.need.sizeBytes = std::max(item.need.sizeBytes, need.sizeBytes);
+        item.need.alignment = std::max(item.need.alignment, need.alignment);
+        item.unaliasedBytes += need.sizeBytes;
+    }
+    return plan;
+}
+
+// == FrameGraph::Instantiate ===================================
+// Passes land in the template's local order, so local pass order[k]
+// becomes graph pass firstPass + k. Internal edges are copied already
+// deduplicated; only accesses to bound (external) resources go through
+// the graph's version tracking, to pick up writers outside the instance
+// and to let later passes depend on the instance's writes.
+
+SubgraphInstance FrameGraph::Instantiate(const SubgraphTemplate& tmpl,
+                                         const SubgraphBindings& bindings) {
+    assert(tmpl.IsCompiled() && "Compile() the template before instantiating it");
+
+    auto view = std::make_shared<SubgraphView>();
+    view->viewIndex = bindings.viewIndex;
+    view->handles.resize(tmpl.slots.size());
+
+    // Transients: one fresh graph resource per instance.
+    uint32_t transients = 0;
+    std::vector<const ResourceDesc*> descs(tmpl.slots.size(), nullptr);
+    for (auto& [slot, desc] : bindings.descs) {
+        const ResourceDesc& proto = tmpl.slots[slot.index].prototype;
+        assert(desc.type == proto.type
+               && StateForAccess(desc, false) == StateForAccess(proto, false)
+               && StateForAccess(desc, true)  == StateForAccess(proto, true)
+               && "A Desc() override must keep the prototype's type and states");
+        descs[slot.index] = &desc;
+    }
+    for (auto& [slot, h] : bindings.bound) view->handles[slot.index] = h;
+    for (uint32_t s = 0; s < tmpl.slots.size(); s++) {
+        if (tmpl.slots[s].external) {
+            assert(view->handles[s].IsValid() && "External subgraph slot left unbound");
+            continue;
+        }
+        view->handles[s] = CreateResource(descs[s] ? *descs[s] : tmpl.slots[s].prototype);
+        transients++;
+    }
+
+    SubgraphInstance inst;
+    inst.firstPass = static_cast<uint32_t>(passes.size());
+    inst.passCount = tmpl.PassCount();
+    inst.view      = view;
+    subgraphViews.push_back(view);   // passes point at it until EndFrame()
+
+    std::string suffix = "[" + std::to_string(bindings.viewIndex) + "]";
+
+    for (uint32_t local : tmpl.order) {
+        const auto& lp = tmpl.passes[local];
+        uint32_t p = static_cast<uint32_t>(passes.size());
+
+        passes.emplace_back();
+        RenderPass& rp = passes.back();
+        rp.name       = tmpl.qualifiedNames[local] + suffix;
+        rp.Execute    = [exec = &lp.exec, v = view.get()]() { (*exec)(*v); };
+        rp.depsUnique = true;
+
+        rp.dependsOn.reserve(lp.dependsOn.size());
+        for (uint32_t dep : lp.dependsOn)
+            rp.dependsOn.push_back(inst.firstPass + tmpl.orderPos[dep]);
+
+        rp.reads.reserve(lp.reads.size());
+        for (uint32_t s : lp.reads) {
+            ResourceHandle h = view->handles[s];
+            rp.reads.push_back(h);
+            if (!tmpl.slots[s].external) continue;
+            auto& ver = entries[h.index].versions.back();
+            if (ver.HasWriter() && std::find(rp.dependsOn.begin(), rp.dependsOn.end(),
+                                             ver.writerPass) == rp.dependsOn.end())
+                rp.dependsOn.push_back(ver.writerPass);
+            ver.readerPasses.push_back(p);
+        }
+
+        rp.writes.reserve(lp.writes.size());
+        for (uint32_t s : lp.writes) {
+            ResourceHandle h = view->handles[s];
+            rp.writes.push_back(h);
+            if (!tmpl.slots[s].external) continue;
+            entries[h.index].versions.push_back({});
+            entries[h.index].versions.back().writerPass = p;
+        }
+        if (capture) CaptureResolvedPass(p);
+    }
+
+    AddGroup(inst.firstPass, inst.passCount, tmpl.plan, view.get(), bindings.descs.empty());
+    if (capture) CaptureGroup(inst.passCount, transients);
+    return inst;
+}
+
+// == FrameGraph::GroupPasses ===================================
+// Rebuilds an instance from passes that were declared one by one (a
+// replayed capture). Slots are the trailing transients in creation
+// order, then every other resource the passes touch, in first-access
+// order — what PlanSubgraph() needs, without the template.
+
+bool FrameGraph::GroupPasses(uint32_t passCount, uint32_t transientCount) {
+    if (passCount == 0 || passCount > passes.size() || transientCount > entries.size())
+        return false;
+    const uint32_t first          = static_cast<uint32_t>(passes.size()) - passCount;
+    const uint32_t firstTransient = static_cast<uint32_t>(entries.size()) - transientCount;
+    if (passes[first].group != UINT32_MAX) return false;
+
+    auto view = std::make_shared<SubgraphView>();
+    SubgraphShape shape;
+    std::vector<uint32_t> slotOf(entries.size(), UINT32_MAX);
+    auto AddSlot = [&](uint32_t r, bool external) {
+        slotOf[r] = static_cast<uint32_t>(view->handles.size());
+        view->handles.push_back({ r });
+        shape.external.push_back(external);
+        shape.descs.push_back(entries[r].desc);
+    };
+    for (uint32_t r = firstTransient; r < entries.size(); r++) AddSlot(r, false);
+
+    auto SlotOf = [&](ResourceHandle h) {
+        if (slotOf[h.index] == UINT32_MAX) AddSlot(h.index, true);
+        return slotOf[h.index];
+    };
+    shape.passes.resize(passCount);
+    for (uint32_t k = 0; k < passCount; k++) {
+        const RenderPass& rp = passes[first + k];
+        auto& sp = shape.passes[k];
+        for (auto& h : rp.reads)  sp.reads.push_back(SlotOf(h));
+        for (auto& h : rp.writes) sp.writes.push_back(SlotOf(h));
+        for (uint32_t dep : rp.dependsOn) {
+            if (dep < first) continue;
+            if (dep >= first + k) return false;   // not in a valid local order
+            sp.dependsOn.push_back(dep - first);
+        }
+    }
+
+    subgraphViews.push_back(view);
+    AddGroup(first, passCount, std::make_shared<const SubgraphPlan>(PlanSubgraph(shape)),
+             view.get(), true);
+    return true;
+}
+
+// Records [firstPass, firstPass + passCount) as one scheduling unit.
+// Its edges to the rest of the graph are the outside writers it reads.
+void FrameGraph::AddGroup(uint32_t firstPass, uint32_t passCount,
+                          std::shared_ptr<const SubgraphPlan> plan, const SubgraphView* view,
+                          bool planDescs) {
+    PassGroup g;
+    g.firstPass = firstPass;
+    g.passCount = passCount;
+    g.view      = view;
+    g.planDescs = planDescs;
+    for (uint32_t k = 0; k < passCount; k++) {
+        RenderPass& rp = passes[firstPass + k];
+        rp.group = static_cast<uint32_t>(groups.size());
+        for (uint32_t dep : rp.dependsOn) {
+            if (dep >= firstPass) continue;
+            g.externalDeps.push_back(dep);
+            if (plan->alive[k]) g.liveDeps.push_back(dep);
+        }
+    }
+    for (auto* deps : { &g.externalDeps, &g.liveDeps }) {
+        std::sort(deps->begin(), deps->end());
+        deps->erase(std::unique(deps->begin(), deps->end()), deps->end());
+    }
+    g.plan = std::move(plan);
+    groups.push_back(std::move(g));
+}
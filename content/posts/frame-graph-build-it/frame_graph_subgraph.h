@@ -0,0 +1,187 @@
+#pragma once
+// Frame Graph — subgraph templates instantiated per view
+// Split-screen, shadow cascades and reflection probes build the same chain
+// of passes once per view. A SubgraphTemplate declares that chain once and
+// compiles it once (setup lambdas, versioning, edge dedup, local order);
+// each FrameGraph::Instantiate() then splices a pre-resolved copy into the
+// graph with its own transient resources and bindings. Instance
+// transients are ordinary graph resources, so aliasing packs every
+// instance together.
+//
+// Usage:
+//   SubgraphTemplate shadow("Shadow");
+//   auto depth = shadow.Transient({2048, 2048, Format::D32F});
+//   auto out   = shadow.External();
+//   shadow.AddPass("Depth",  [&]() { shadow.Write(0, depth); }, drawFn);
+//   shadow.AddPass("Filter", [&]() { shadow.Read(1, depth); shadow.Write(1, out); }, filterFn);
+//   shadow.Compile();
+//   for (uint32_t c = 0; c < 4; c++)
+//       fg.Instantiate(shadow, SubgraphBindings(c).Bind(out, esm[c]));
+//
+// Compile() also precomputes the instance's liveness, slot lifetimes,
+// transient barriers and transient packing, and the graph sorts, culls,
+// scans and aliases each instance as one unit from that plan. So a live
+// instance runs every pass that feeds any of its external outputs, and
+// instance transients cannot be read from outside the instance. An
+// instance that keeps the prototype descs is also aliased from the
+// template's block layout (sizes and local lifetimes), shifted to where
+// it landed.
+//
+// That makes each instance cheaper, not free: every view still adds its
+// own passes, resources and aliased blocks, so frame cost stays linear
+// in the number of views, at a lower per-view constant. Past a few
+// hundred views, also pass a BitsetBlockSearch: the default free-list
+// scan is quadratic in blocks.
+//
+// Instance passes call into the template's exec functions, so the
+// template must outlive every frame it was instantiated into.
+//
+// Compile: g++ -std=c++17 -O2 -o example_subgraph example_subgraph.cpp frame_graph_v3.cpp frame_graph_subgraph.cpp
+
+#include "frame_graph_v3.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// == Template-local resource slot ==============================
+struct SubgraphSlot {
+    uint32_t index = UINT32_MAX;
+    bool IsValid() const { return index != UINT32_MAX; }
+};
+
+// == What a pass sees when it executes =========================
+struct SubgraphView {
+    uint32_t viewIndex = 0;
+    std::vector<ResourceHandle> handles;   // by slot index
+    ResourceHandle operator[](SubgraphSlot s) const { return handles[s.index]; }
+};
+
+// == Per-instance bindings =====================================
+struct SubgraphBindings {
+    explicit SubgraphBindings(uint32_t viewIndex = 0) : viewIndex(viewIndex) {}
+
+    // External slots must be bound to a graph resource.
+    SubgraphBindings& Bind(SubgraphSlot slot, ResourceHandle h) {
+        bound.push_back({ slot, h });
+        return *this;
+    }
+    // Transient slots use the template's prototype desc unless overridden.
+    SubgraphBindings& Desc(SubgraphSlot slot, const ResourceDesc& desc) {
+        descs.push_back({ slot, desc });
+        return *this;
+    }
+
+    uint32_t viewIndex;
+    std::vector<std::pair<SubgraphSlot, ResourceHandle>> bound;
+    std::vector<std::pair<SubgraphSlot, ResourceDesc>>   descs;
+};
+
+// == Precomputed once per template ============================
+// Everything Compile() needs to treat an instance as one unit. Indices
+// are local positions (template order) and template slots; FrameGraph
+// shifts and maps them per instance.
+struct SubgraphPlan {
+    // One access in a pass, in the order the pass declared it (reads,
+    // then writes). Transient slots start Undefined in every instance,
+    // so their transitions are resolved here; external slots are
+    // resolved per instance against the graph's state.
+    struct Step {
+        uint32_t      slot     = 0;
+        bool          external = false;
+        bool          write    = false;
+        ResourceState before   = ResourceState::Undefined;   // transient only
+        ResourceState after    = ResourceState::Undefined;
+    };
+
+    std::vector<uint8_t>  alive;       // by position: feeds an external write
+    std::vector<Lifetime> slotLife;    // by slot, over live positions
+    std::vector<Step>     steps;       // external accesses + transient transitions
+    std::vector<uint32_t> stepFirst;   // by position, size = passes + 1
+    std::vector<std::vector<uint32_t>> blocks;   // transient slots sharing one physical block
+
+    // What AliasResources() places for each block, so an instance with
+    // the prototype descs costs one item per block and no footprints.
+    struct BlockItem {
+        Lifetime     life;                 // local positions, union of occupants
+        Footprint    need;                 // largest occupant
+        ResourceType type = ResourceType::Texture;
+        uint64_t     unaliasedBytes = 0;   // sum of occupants, for the log
+    };
+    std::vector<BlockItem> blockItems;   // by block
+};
+
+// What PlanSubgraph() reads — from a template, or from a replayed capture.
+struct SubgraphShape {
+    struct Pass {
+        std::vector<uint32_t> reads, writes;   // slots
+        std::vector<uint32_t> dependsOn;       // earlier positions
+    };
+    std::vector<Pass>         passes;     // by position
+    std::vector<bool>         external;   // by slot
+    std::vector<ResourceDesc> descs;      // by slot; transients only
+};
+
+SubgraphPlan PlanSubgraph(const SubgraphShape& shape);
+
+// == Template ==================================================
+class SubgraphTemplate {
+public:
+    using ExecFn = std::function<void(const SubgraphView&)>;
+
+    explicit SubgraphTemplate(std::string name) : name(std::move(name)) {}
+
+    SubgraphSlot Transient(const ResourceDesc& prototype);
+    SubgraphSlot External();
+
+    // Same shape as FrameGraph: setup runs now and declares accesses
+    // with the template-local pass index.
+    template <typename SetupFn>
+    void AddPass(const std::string& passName, SetupFn&& setup, ExecFn exec) {
+        passes.push_back({ passName, std::move(exec) });
+        std::forward<SetupFn>(setup)();
+        compiled = false;
+    }
+    void Read(uint32_t localPass, SubgraphSlot slot);
+    void Write(uint32_t localPass, SubgraphSlot slot);
+
+    // Once, after the last AddPass: dedups edges and fixes the local
+    // topological order every instance reuses.
+    void Compile();
+
+    bool     IsCompiled() const { return compiled; }
+    uint32_t PassCount()  const { return static_cast<uint32_t>(passes.size()); }
+
+private:
+    friend class FrameGraph;
+
+    struct Slot {
+        bool         external = false;
+        ResourceDesc prototype;
+        uint32_t     lastWriter = UINT32_MAX;   // local pass, during declaration
+    };
+    struct LocalPass {
+        std::string           name;
+        ExecFn                exec;
+        std::vector<uint32_t> reads;       // slot indices
+        std::vector<uint32_t> writes;
+        std::vector<uint32_t> dependsOn;   // local pass indices
+    };
+
+    std::string            name;
+    std::vector<Slot>      slots;
+    std::vector<LocalPass> passes;
+    std::vector<uint32_t>  order;          // local topo order
+    std::vector<uint32_t>  orderPos;       // local pass -> position in order
+    std::vector<std::string> qualifiedNames;   // "Template/Pass", by local pass
+    std::shared_ptr<const SubgraphPlan> plan;  // shared by every instance
+    bool compiled = false;
+};
+
+// == Returned by FrameGraph::Instantiate =======================
+struct SubgraphInstance {
+    uint32_t firstPass = 0;   // instance passes are [firstPass, firstPass + count)
+    uint32_t passCount = 0;
+    std::shared_ptr<const SubgraphView> view;
+};
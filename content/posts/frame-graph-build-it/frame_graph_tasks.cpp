@@ -0,0 +1,174 @@
+#include "frame_graph_tasks.h"
+#include "frame_graph_v3.h"
+#include "frame_graph_trace.h"
+
+// == TaskScheduler =============================================
+
+namespace {
+struct WorkerSlot {
+    const TaskScheduler* owner = nullptr;
+    uint32_t             index = 0;
+};
+thread_local WorkerSlot tlsWorker;
+}
+
+TaskScheduler::TaskScheduler(uint32_t workerCount) {
+    for (uint32_t i = 0; i < workerCount + 1; i++)
+        deques.push_back(std::make_unique<WorkDeque>());
+    for (uint32_t i = 0; i < workerCount; i++)
+        threads.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+uint32_t TaskScheduler::SelfIndex() const {
+    if (tlsWorker.owner == this) return tlsWorker.index;
+    return static_cast<uint32_t>(deques.size() - 1);   // shared deque
+}
+
+void TaskScheduler::Push(uint32_t task) {
+    WorkDeque& dq = *deques[SelfIndex()];
+    {
+        std::lock_guard<std::mutex> lock(dq.lock);
+        dq.tasks.push_back(task);
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    // Empty critical section: a worker that just saw queued == 0 is
+    // either still before its wait (and will re-check) or already asleep.
+    { std::lock_guard<std::mutex> lock(sleepLock); }
+    wake.notify_one();
+}
+
+bool TaskScheduler::Take(uint32_t self, uint32_t& task) {
+    {
+        WorkDeque& own = *deques[self];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    uint32_t n = static_cast<uint32_t>(deques.size());
+    for (uint32_t k = 1; k < n; k++) {
+        WorkDeque& victim = *deques[(self + k) % n];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::RunOne() {
+    uint32_t task;
+    if (!Take(SelfIndex(), task)) return false;
+    handler(task);
+    return true;
+}
+
+void TaskScheduler::WorkerLoop(uint32_t self) {
+    tlsWorker = { this, self };
+    while (true) {
+        uint32_t task;
+        if (Take(self, task)) {
+            handler(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [&] {
+            return stopping.load() || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping.load()) return;
+    }
+}
+
+// == FrameGraph::Execute on a task scheduler ===================
+// pending[i] starts at the pass's deduplicated in-degree; finishing a
+// pass decrements its successors and queues any Cpu pass that hits zero.
+// Dead passes never finish, but culling guarantees no live pass waits
+// on one. Barriers are resolved up front in sorted order, and every
+// pass's slice — Cpu jobs included — is emitted on this thread in sorted
+// order, so the plan gets the same barriers as under Execute(plan).
+
+void FrameGraph::Execute(const CompiledPlan& plan, TaskScheduler& scheduler) {
+    Log("[6] Executing (Cpu passes on %u workers):\n", scheduler.WorkerCount());
+    const BarrierSchedule schedule = PlanBarriers(plan);
+
+    std::vector<std::atomic<uint32_t>> pending(passes.size());
+    std::atomic<uint32_t> cpuRemaining{0};
+    for (uint32_t i = 0; i < passes.size(); i++) {
+        pending[i].store(passes[i].inDegree, std::memory_order_relaxed);
+        if (passes[i].alive && passes[i].kind == PassKind::Cpu)
+            cpuRemaining.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto Finish = [&](uint32_t idx) {
+        for (uint32_t succ : passes[idx].successors) {
+            if (pending[succ].fetch_sub(1, std::memory_order_acq_rel) == 1
+                && passes[succ].alive && passes[succ].kind == PassKind::Cpu)
+                scheduler.Push(succ);
+        }
+    };
+
+    scheduler.SetHandler([&](uint32_t idx) {
+        if (tracer || capture) {
+            uint64_t begin = FrameTracer::NowNs();
+            passes[idx].Execute();
+            RecordPassTime(idx, begin, FrameTracer::NowNs(), schedule.Count(idx));
+        } else {
+            passes[idx].Execute();
+        }
+        Finish(idx);
+        cpuRemaining.fetch_sub(1, std::memory_order_release);
+    });
+
+    for (uint32_t idx : plan.sorted) {
+        if (passes[idx].alive && passes[idx].kind == PassKind::Cpu
+            && passes[idx].inDegree == 0)
+            scheduler.Push(idx);
+    }
+
+    // Gpu passes: strict sorted order on this thread, helping with Cpu
+    // work while a producer is still running elsewhere.
+    for (uint32_t idx : plan.sorted) {
+        if (!passes[idx].alive) {
+            Log("  -- skip: %s (CULLED)\n", passes[idx].name.c_str());
+            continue;
+        }
+        if (passes[idx].kind == PassKind::Cpu) {
+            EmitBarriers(schedule, idx);   // the job itself may run anywhere
+            continue;
+        }
+
+        while (pending[idx].load(std::memory_order_acquire) != 0) {
+            if (!scheduler.RunOne()) std::this_thread::yield();
+        }
+        if (tracer || capture) {
+            ExecutePassTraced(idx, &schedule);
+        } else {
+            EmitBarriers(schedule, idx);
+            passes[idx].Execute(/* &cmdList */);
+        }
+        Finish(idx);
+    }
+
+    // The handler stays installed (and dangling) until the next run; it
+    // is only ever invoked for queued tasks, and none are left.
+    while (cpuRemaining.load(std::memory_order_acquire) != 0) {
+        if (!scheduler.RunOne()) std::this_thread::yield();
+    }
+
+    EndFrame();
+}
@@ -0,0 +1,68 @@
+#pragma once
+// Frame Graph — work-stealing task scheduler for Cpu passes
+// Passes added with PassKind::Cpu (visibility, skinning prep, constant
+// upload...) run on worker threads the moment their last producer
+// finishes, tracked by an atomic in-degree per pass. Gpu passes keep
+// recording in sorted order on the thread that calls Execute.
+//
+// Usage:
+//   TaskScheduler scheduler;              // hardware_concurrency() - 1 workers
+//   auto plan = fg.Compile();
+//   fg.Execute(plan, scheduler);
+//
+// Compile: g++ -std=c++17 -O2 -pthread -o example_tasks example_tasks.cpp frame_graph_v3.cpp frame_graph_tasks.cpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskScheduler {
+public:
+    explicit TaskScheduler(uint32_t workerCount = DefaultWorkerCount());
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    static uint32_t DefaultWorkerCount() {
+        uint32_t hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 1;
+    }
+    uint32_t WorkerCount() const { return static_cast<uint32_t>(threads.size()); }
+
+    // Every task id pushed until the next SetHandler() runs through `fn`.
+    // Only change the handler while no tasks are queued or running.
+    void SetHandler(std::function<void(uint32_t)> fn) { handler = std::move(fn); }
+
+    // Workers push to their own deque; other threads share the last one.
+    void Push(uint32_t task);
+
+    // Run one queued task on the calling thread; false if none was found.
+    // Lets the submitting thread help instead of spinning.
+    bool RunOne();
+
+private:
+    // Owner pops from the back (LIFO, cache-warm), thieves take the front.
+    struct alignas(64) WorkDeque {
+        std::mutex           lock;
+        std::deque<uint32_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkDeque>> deques;   // workers + 1 shared
+    std::vector<std::thread>                threads;
+    std::function<void(uint32_t)>           handler;
+
+    std::atomic<int64_t>    queued{0};
+    std::atomic<bool>       stopping{false};
+    std::mutex              sleepLock;
+    std::condition_variable wake;
+
+    uint32_t SelfIndex() const;
+    bool     Take(uint32_t self, uint32_t& task);
+    void     WorkerLoop(uint32_t self);
+};
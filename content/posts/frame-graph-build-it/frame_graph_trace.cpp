@@ -0,0 +1,74 @@
+#include "frame_graph_trace.h"
+#include <algorithm>
+#include <cstdio>
+
+// == Chrome trace JSON =========================================
+// "X" (complete) events, timestamps in microseconds relative to the
+// earliest recorded event so Perfetto starts the timeline at zero.
+
+size_t FrameTracer::EventCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t count = 0;
+    for (auto& ring : rings) {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        count += static_cast<size_t>(std::min<uint64_t>(head, TraceRing::kCapacity));
+    }
+    return count;
+}
+
+size_t FrameTracer::RingCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return rings.size();
+}
+
+// Pass names are user strings: escape what JSON does not allow raw.
+static void WriteJsonString(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') { fputc('\\', f); fputc(c, f); }
+        else if (c < 0x20)          fprintf(f, "\\u%04x", c);
+        else                        fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+bool FrameTracer::WriteChromeTrace(const char* path) const {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    uint64_t origin = UINT64_MAX;
+    for (auto& ring : rings) {
+        uint64_t head  = ring->head.load(std::memory_order_acquire);
+        uint64_t first = head > TraceRing::kCapacity ? head - TraceRing::kCapacity : 0;
+        for (uint64_t i = first; i < head; i++)
+            origin = std::min(origin, ring->events[i & (TraceRing::kCapacity - 1)].beginNs);
+    }
+
+    fprintf(f, "{\"traceEvents\":[\n");
+    bool firstEvent = true;
+    for (auto& ring : rings) {
+        uint64_t head  = ring->head.load(std::memory_order_acquire);
+        uint64_t first = head > TraceRing::kCapacity ? head - TraceRing::kCapacity : 0;
+        for (uint64_t i = first; i < head; i++) {
+            const TraceEvent& e = ring->events[i & (TraceRing::kCapacity - 1)];
+            bool isPass = e.barriers != TraceEvent::kNoBarriers;
+            fprintf(f, "%s  {\"name\":", firstEvent ? "" : ",\n");
+            WriteJsonString(f, e.name);
+            fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\","
+                       "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u",
+                    isPass ? "execute" : "compile",
+                    (e.beginNs - origin) / 1000.0,
+                    (e.endNs - e.beginNs) / 1000.0,
+                    ring->threadId);
+            if (isPass) fprintf(f, ",\"args\":{\"barriers\":%u}", e.barriers);
+            fprintf(f, "}");
+            firstEvent = false;
+        }
+    }
+    fprintf(f, "\n],\"displayTimeUnit\":\"ns\"}\n");
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,130 @@
+#pragma once
+// Frame Graph — Chrome trace / Perfetto export
+// Records begin/end timestamps for every Compile() phase and every
+// executed pass into per-thread ring buffers, then dumps them as Chrome
+// trace JSON (open in chrome://tracing or ui.perfetto.dev).
+//
+// Opt-in: attach with FrameGraph::SetTracer(&tracer). With no tracer the
+// graph pays one null check per phase / pass.
+//
+// Compile: g++ -std=c++17 -o example_trace example_trace.cpp frame_graph_v3.cpp frame_graph_trace.cpp
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// == One timed span ============================================
+struct TraceEvent {
+    static constexpr uint32_t kNoBarriers = UINT32_MAX;   // compile phases
+
+    char     name[48] = {};    // copied — pass names die with the graph
+    uint64_t beginNs  = 0;
+    uint64_t endNs    = 0;
+    uint32_t barriers = kNoBarriers;
+};
+
+// == Single-producer ring, one per recording thread ============
+// Only the owning thread writes; the dump reads up to `head` after an
+// acquire load. Oldest events are overwritten when the ring wraps.
+struct TraceRing {
+    static constexpr uint32_t kCapacity = 4096;   // power of two
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be 2^n");
+
+    uint32_t threadId = 0;
+    std::atomic<uint64_t> head{0};
+    std::array<TraceEvent, kCapacity> events;
+
+    void Push(const TraceEvent& e) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        events[h & (kCapacity - 1)] = e;
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+// == Tracer ====================================================
+class FrameTracer {
+public:
+    FrameTracer() : id(NextId()) {}
+    FrameTracer(const FrameTracer&) = delete;
+    FrameTracer& operator=(const FrameTracer&) = delete;
+
+    static uint64_t NowNs() {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(
+            steady_clock::now().time_since_epoch()).count();
+    }
+
+    void Record(const char* name, uint64_t beginNs, uint64_t endNs,
+                uint32_t barriers = TraceEvent::kNoBarriers) {
+        TraceEvent e;
+        // Truncate long names at a UTF-8 code point boundary: a split
+        // sequence would make the JSON file invalid.
+        size_t n = strnlen(name, sizeof(e.name));
+        if (n == sizeof(e.name)) {
+            n = sizeof(e.name) - 1;
+            while (n > 0 && (static_cast<unsigned char>(name[n]) & 0xC0) == 0x80) n--;
+        }
+        memcpy(e.name, name, n);
+        e.beginNs  = beginNs;
+        e.endNs    = endNs;
+        e.barriers = barriers;
+        LocalRing().Push(e);
+    }
+
+    // Call while no thread is recording (e.g. between frames).
+    bool WriteChromeTrace(const char* path) const;
+    size_t EventCount() const;
+    size_t RingCount() const;   // one per thread that has recorded
+
+private:
+    const uint64_t id;   // distinguishes tracers reusing the same address
+    mutable std::mutex registryMutex;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+
+    static uint64_t NextId() {
+        static std::atomic<uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Lock-free after the first event on each thread: every thread keeps a
+    // small id -> ring table (one entry per tracer it has recorded into),
+    // the registry lock is only taken to create a ring. Alternating between
+    // tracers on one thread reuses each tracer's ring instead of allocating.
+    TraceRing& LocalRing() {
+        struct CachedRing { uint64_t id; TraceRing* ring; };
+        thread_local std::vector<CachedRing> cache;
+        for (auto& c : cache)
+            if (c.id == id) return *c.ring;
+
+        TraceRing* ring;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            rings.push_back(std::make_unique<TraceRing>());
+            rings.back()->threadId = static_cast<uint32_t>(rings.size() - 1);
+            ring = rings.back().get();
+        }
+        cache.push_back({ id, ring });
+        return *ring;
+    }
+};
+
+// == RAII span for compile phases ==============================
+class TraceScope {
+public:
+    TraceScope(FrameTracer* tracer, const char* name)
+        : tracer(tracer), name(name),
+          beginNs(tracer ? FrameTracer::NowNs() : 0) {}
+    ~TraceScope() {
+        if (tracer) tracer->Record(name, beginNs, FrameTracer::NowNs());
+    }
+
+private:
+    FrameTracer* tracer;
+    const char*  name;
+    uint64_t     beginNs;
+};
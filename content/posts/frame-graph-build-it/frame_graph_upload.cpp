@@ -0,0 +1,95 @@
+#include "frame_graph_upload.h"
+#include <cassert>
+
+// == Per-frame upload ring =====================================
+
+void UploadRing::OnCompiled(const FrameGraph& fg, const FrameGraph::CompiledPlan&) {
+    passBytes = std::vector<std::atomic<uint64_t>>(fg.Passes().size());
+}
+
+UploadAllocation UploadRing::Allocate(uint32_t passIdx, uint64_t size, uint64_t alignment) {
+    assert(passIdx < passBytes.size() && "Allocate() is for Execute callbacks of a compiled graph");
+    passBytes[passIdx].fetch_add(size, std::memory_order_relaxed);
+    while (true) {
+        Segment* seg = current.load(std::memory_order_acquire);
+        if (seg) {
+            uint64_t used = seg->used.load(std::memory_order_relaxed);
+            uint64_t begin;
+            do {
+                begin = AlignUp(used, alignment);
+                if (begin + size > seg->size) break;
+            } while (!seg->used.compare_exchange_weak(used, begin + size,
+                                                      std::memory_order_relaxed));
+            if (begin + size <= seg->size) {
+                bytesThisFrame.fetch_add(size, std::memory_order_relaxed);
+                return { seg->memory.get() + begin, seg->index, begin, size };
+            }
+        }
+
+        // Slow path: current segment is full (or the frame has none yet).
+        std::lock_guard<std::mutex> lock(rollover);
+        if (size > segmentSize) {
+            // Dedicated segment; the shared one keeps serving small requests.
+            Segment* big = TakeSegment(size);
+            big->used.store(size, std::memory_order_relaxed);
+            bytesThisFrame.fetch_add(size, std::memory_order_relaxed);
+            return { big->memory.get(), big->index, 0, size };
+        }
+        if (current.load(std::memory_order_relaxed) == seg)   // nobody beat us to it
+            current.store(TakeSegment(segmentSize), std::memory_order_release);
+    }
+}
+
+UploadRing::Segment* UploadRing::TakeSegment(uint64_t minSize) {
+    Segment* seg = nullptr;
+    for (uint32_t i = 0; i < freeList.size(); i++) {
+        if (freeList[i]->size < minSize) continue;
+        seg = freeList[i];
+        freeList.erase(freeList.begin() + i);
+        stats.segmentsRecycled++;
+        break;
+    }
+    if (!seg) {
+        segments.push_back(std::make_unique<Segment>());
+        seg = segments.back().get();
+        seg->memory.reset(new uint8_t[minSize]);
+        seg->size  = minSize;
+        seg->index = static_cast<uint32_t>(segments.size() - 1);
+        stats.segmentsCreated++;
+    }
+    seg->used.store(0, std::memory_order_relaxed);
+    thisFrame.push_back(seg);
+    return seg;
+}
+
+void UploadRing::OnEndFrame(const FrameGraph& fg) {
+    // Called between frames: no pass is recording, so no lock needed.
+    std::vector<PassUpload> perPass;
+    for (uint32_t i = 0; i < passBytes.size() && i < fg.Passes().size(); i++) {
+        uint64_t bytes = passBytes[i].load(std::memory_order_relaxed);
+        if (bytes) perPass.push_back({ fg.Passes()[i].name, bytes });
+    }
+    passBytes.clear();
+
+    uint64_t nextFrame = fg.FrameIndex() + 1;
+    for (Segment* seg : thisFrame) {
+        seg->lastFrame = fg.FrameIndex();
+        inFlight.push_back(seg);
+    }
+    thisFrame.clear();
+    current.store(nullptr, std::memory_order_relaxed);
+
+    // Same rule as descriptor slots: untouched for kFramesInFlight frames.
+    for (uint32_t i = 0; i < inFlight.size();) {
+        if (inFlight[i]->lastFrame + kFramesInFlight <= nextFrame) {
+            freeList.push_back(inFlight[i]);
+            inFlight[i] = inFlight.back();
+            inFlight.pop_back();
+        } else {
+            i++;
+        }
+    }
+
+    stats.bytesLastFrame = bytesThisFrame.exchange(0, std::memory_order_relaxed);
+    stats.perPass        = std::move(perPass);
+}
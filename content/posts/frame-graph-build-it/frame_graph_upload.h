@@ -0,0 +1,85 @@
+#pragma once
+// Frame Graph — per-frame upload ring
+// CPU-visible memory for constants and staging data, handed out to pass
+// Execute callbacks by bumping an offset in the current segment. The
+// bump is a CAS, so passes recording on several threads never lock;
+// only rolling over to a fresh segment takes the mutex. Segments a frame
+// touched go back to the free list kFramesInFlight frames later, at the
+// same frame boundary the heap pool and descriptor cache retire at.
+//
+// Usage:
+//   UploadRing uploads;
+//   fg.AddHook(&uploads);
+//   ... in pass `p`'s Execute: UploadAllocation a = uploads.Allocate(p, 256);
+//
+// Compile: g++ -std=c++17 -O2 -pthread -o example_upload example_upload.cpp frame_graph_v3.cpp frame_graph_tasks.cpp frame_graph_upload.cpp
+
+#include "frame_graph_v3.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+constexpr uint64_t kUploadAlignment   = 256;           // constant-buffer rule
+constexpr uint64_t kUploadSegmentSize = 1024 * 1024;
+
+struct UploadAllocation {
+    uint8_t* cpu     = nullptr;   // write your data here
+    uint32_t segment = 0;         // which upload buffer to bind
+    uint64_t offset  = 0;         // byte offset inside it
+    uint64_t size    = 0;
+};
+
+struct PassUpload {
+    std::string name;
+    uint64_t    bytes = 0;
+};
+
+struct UploadStats {
+    uint64_t bytesLastFrame   = 0;
+    uint32_t segmentsCreated  = 0;   // flat once the ring has warmed up
+    uint32_t segmentsRecycled = 0;   // rollovers served from the free list
+    std::vector<PassUpload> perPass; // last finished frame, uploading passes only
+};
+
+class UploadRing : public FrameGraphHook {
+public:
+    // Only before the first Allocate(); oversized requests get their own segment.
+    void SetSegmentSize(uint64_t bytes) { segmentSize = bytes; }
+
+    // Transient CPU-visible memory for the Execute callback of `passIdx`.
+    // Safe to call from any thread recording a pass; valid for this frame.
+    UploadAllocation Allocate(uint32_t passIdx, uint64_t size,
+                              uint64_t alignment = kUploadAlignment);
+
+    void OnCompiled(const FrameGraph& fg, const FrameGraph::CompiledPlan& plan) override;
+    // Closes the frame and recycles segments no frame in flight can
+    // still reference.
+    void OnEndFrame(const FrameGraph& fg) override;
+
+    const UploadStats& Stats() const { return stats; }
+
+private:
+    struct Segment {
+        std::unique_ptr<uint8_t[]> memory;
+        uint64_t              size = 0;
+        std::atomic<uint64_t> used{0};
+        uint64_t              lastFrame = 0;
+        uint32_t              index = 0;
+    };
+
+    uint64_t segmentSize = kUploadSegmentSize;
+    std::vector<std::unique_ptr<Segment>> segments;
+    std::atomic<Segment*> current{nullptr};
+    std::mutex            rollover;
+    std::vector<Segment*> thisFrame;   // touched by the frame being recorded
+    std::vector<Segment*> inFlight;    // waiting out kFramesInFlight
+    std::vector<Segment*> freeList;
+    std::atomic<uint64_t> bytesThisFrame{0};
+    std::vector<std::atomic<uint64_t>> passBytes;   // sized by OnCompiled()
+    UploadStats           stats;
+
+    Segment* TakeSegment(uint64_t minSize);   // under `rollover`
+};
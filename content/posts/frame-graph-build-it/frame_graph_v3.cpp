@@ -1,6 +1,10 @@
 #include "frame_graph_v3.h"
+#include "frame_graph_trace.h"
+#include "frame_graph_capture.h"
+#include "frame_graph_subgraph.h"
 #include <algorithm>
 #include <cassert>
+#include <cstdarg>
 #include <cstdio>
 #include <numeric>
 #include <queue>
@@ -8,18 +12,29 @@
 
 // == FrameGraph implementation =================================
 
+void FrameGraph::Log(const char* fmt, ...) const {
+    if (!verbose) return;
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
 ResourceHandle FrameGraph::CreateResource(const ResourceDesc& desc) {
+    if (capture) capture->OnCreateResource(desc);
     entries.push_back({ desc, {{}}, ResourceState::Undefined });
     return { static_cast<uint32_t>(entries.size() - 1) };
 }
 
 ResourceHandle FrameGraph::ImportResource(const ResourceDesc& desc,
                                           ResourceState initialState) {
+    if (capture) capture->OnImportResource(desc, initialState);
     entries.push_back({ desc, {{}}, initialState, true });
     return { static_cast<uint32_t>(entries.size() - 1) };
 }
 
 void FrameGraph::Read(uint32_t passIdx, ResourceHandle h) {
+    if (capture) capture->OnRead(passIdx, h);
     auto& ver = entries[h.index].versions.back();
     if (ver.HasWriter()) {
         passes[passIdx].dependsOn.push_back(ver.writerPass);
@@ -29,6 +44,7 @@ void FrameGraph::Read(uint32_t passIdx, ResourceHandle h) {
 }
 
 void FrameGraph::Write(uint32_t passIdx, ResourceHandle h) {
+    if (capture) capture->OnWrite(passIdx, h);
     entries[h.index].versions.push_back({});
     entries[h.index].versions.back().writerPass = passIdx;
     passes[passIdx].writes.push_back(h);
@@ -36,46 +52,132 @@ void FrameGraph::Write(uint32_t passIdx, ResourceHandle h) {
 
 // == v3: compile â€” builds the execution plan + allocates memory ==
 
-FrameGraph::CompiledPlan FrameGraph::Compile() {
-    printf("\n[1] Building dependency edges...\n");
-    BuildEdges();
-    printf("[2] Topological sort...\n");
-    auto sorted   = TopoSort();
-    printf("[3] Culling dead passes...\n");
-    Cull(sorted);
-    printf("[4] Scanning resource lifetimes...\n");
-    auto lifetimes = ScanLifetimes(sorted);   // NEW v3
-    printf("[5] Aliasing resources (greedy free-list)...\n");
-    auto mapping   = AliasResources(lifetimes); // NEW v3
+FrameGraph::CompiledPlan FrameGraph::Compile(const CompileOptions& options) {
+    TraceScope compileScope(tracer, "Compile");
+    if (capture) CaptureCompile(options, false, 0);
+    CompiledPlan plan = BuildPlan(options);
+    FinishPlan(plan);
 
     // Physical bindings are now decided â€” execute can't change them.
     // This makes the compiled plan cacheable and thread-safe.
-    return { std::move(sorted), std::move(mapping) };
+    return plan;
+}
+
+// Steps [1]-[5]: the plan itself.
+FrameGraph::CompiledPlan FrameGraph::BuildPlan(const CompileOptions& options) {
+    Log("\n[1] Building dependency edges...\n");
+    { TraceScope s(tracer, "BuildEdges"); BuildEdges(); }
+    Log("[2] Topological sort...\n");
+    std::vector<uint32_t> sorted;
+    { TraceScope s(tracer, "TopoSort"); sorted = TopoSort(); }
+    Log("[3] Culling dead passes...\n");
+    { TraceScope s(tracer, "Cull"); Cull(sorted); }
+    Log("[4] Scanning resource lifetimes...\n");
+    std::vector<Lifetime> lifetimes;
+    { TraceScope s(tracer, "ScanLifetimes"); lifetimes = ScanLifetimes(sorted); }  // NEW v3
+    Log("[5] Aliasing resources (%s)...\n",
+        options.blockSearch ? "indexed first-fit" : "greedy free-list");
+    std::vector<uint32_t> mapping;
+    std::vector<PhysicalBlock> blocks;
+    { TraceScope s(tracer, "AliasResources");
+      mapping = AliasResources(lifetimes, blocks, options.blockSearch); }       // NEW v3
+
+    CompiledPlan plan{ std::move(sorted), std::move(mapping),
+                       std::move(blocks), std::move(lifetimes) };
+    for (auto& blk : plan.blocks) plan.memoryBytes += blk.sizeBytes;
+    return plan;
+}
+
+// What a finished plan sets up for execution.
+void FrameGraph::FinishPlan(CompiledPlan& plan) {
+    for (FrameGraphHook* hook : hooks) hook->OnCompiled(*this, plan);
 }
 
 // == v3: execute â€” runs the compiled plan =====================
 
 void FrameGraph::Execute(const CompiledPlan& plan) {
-    printf("[6] Executing (with automatic barriers):\n");
+    Log("[6] Executing (with automatic barriers):\n");
     for (uint32_t idx : plan.sorted) {
         if (!passes[idx].alive) {
-            printf("  -- skip: %s (CULLED)\n", passes[idx].name.c_str());
+            Log("  -- skip: %s (CULLED)\n", passes[idx].name.c_str());
+            continue;
+        }
+        if (tracer || capture) {    // the only cost when both are off
+            ExecutePassTraced(idx);
             continue;
         }
         InsertBarriers(idx);
         passes[idx].Execute(/* &cmdList */);
     }
-    passes.clear();
-    entries.clear();
+    EndFrame();
+}
+
+void FrameGraph::ExecutePassTraced(uint32_t passIdx, const BarrierSchedule* schedule) {
+    uint64_t begin    = FrameTracer::NowNs();
+    uint32_t barriers = schedule ? EmitBarriers(*schedule, passIdx) : InsertBarriers(passIdx);
+    passes[passIdx].Execute(/* &cmdList */);
+    RecordPassTime(passIdx, begin, FrameTracer::NowNs(), barriers);
+}
+
+// Executors that record a pass in several slices (coroutines) report
+// each one; a capture sums them per pass.
+void FrameGraph::RecordPassTime(uint32_t passIdx, uint64_t beginNs, uint64_t endNs,
+                                uint32_t barriers) {
+    if (tracer)
+        tracer->Record(passes[passIdx].name.c_str(), beginNs, endNs, barriers);
+    if (capture && capture->RecordsTimings())
+        capture->OnPassTime(passIdx, endNs - beginNs);
+}
+
+void FrameGraph::CaptureAddPass(uint32_t passIdx) {
+    capture->OnAddPass(passes[passIdx].name, passes[passIdx].kind);
+}
+
+void FrameGraph::CaptureResolvedPass(uint32_t passIdx) {
+    CaptureAddPass(passIdx);
+    for (auto& h : passes[passIdx].reads)  capture->OnRead(passIdx, h);
+    for (auto& h : passes[passIdx].writes) capture->OnWrite(passIdx, h);
+}
+
+void FrameGraph::CaptureGroup(uint32_t passCount, uint32_t transientCount) {
+    capture->OnGroup(passCount, transientCount);
+}
+
+void FrameGraph::CaptureCompile(const CompileOptions& options, bool budgeted,
+                                uint64_t memoryBudget) {
+    capture->OnCompile(heapTier, options, budgeted, memoryBudget, resolutionScale);
 }
 
 // convenience: compile + execute in one call
 void FrameGraph::Execute() { Execute(Compile()); }
 
+// Every executor ends here. The plan's physical blocks and descriptors
+// stay valid for the GPU; the graph itself is rebuilt next frame.
+void FrameGraph::EndFrame() {
+    if (capture) capture->OnEndFrame();
+    for (FrameGraphHook* hook : hooks) hook->OnEndFrame(*this);
+
+    passes.clear();
+    entries.clear();
+    subgraphViews.clear();
+    groups.clear();
+    frameIndex++;
+}
+
 // == Build dependency edges ====================================
 
 void FrameGraph::BuildEdges() {
+    // Start from scratch so Compile() can run more than once per graph.
+    for (auto& pass : passes) {
+        pass.successors.clear();
+        pass.inDegree = 0;
+    }
     for (uint32_t i = 0; i < passes.size(); i++) {
+        if (passes[i].depsUnique) {
+            for (uint32_t dep : passes[i].dependsOn) passes[dep].successors.push_back(i);
+            passes[i].inDegree = static_cast<uint32_t>(passes[i].dependsOn.size());
+            continue;
+        }
         std::unordered_set<uint32_t> seen;
         for (uint32_t dep : passes[i].dependsOn) {
             if (seen.insert(dep).second) {
@@ -89,26 +191,50 @@ void FrameGraph::BuildEdges() {
 // == Kahn's topological sort â€” O(V + E) ========================
 
 std::vector<uint32_t> FrameGraph::TopoSort() {
-    std::queue<uint32_t> q;
-    std::vector<uint32_t> inDeg(passes.size());
-    for (uint32_t i = 0; i < passes.size(); i++) {
-        inDeg[i] = passes[i].inDegree;
-        if (inDeg[i] == 0) q.push(i);
-    }
     std::vector<uint32_t> order;
-    while (!q.empty()) {
-        uint32_t cur = q.front(); q.pop();
-        order.push_back(cur);
-        for (uint32_t succ : passes[cur].successors) {
-            if (--inDeg[succ] == 0)
-                q.push(succ);
+    std::queue<uint32_t> q;
+    if (groups.empty()) {
+        std::vector<uint32_t> inDeg(passes.size());
+        for (uint32_t i = 0; i < passes.size(); i++) {
+            inDeg[i] = passes[i].inDegree;
+            if (inDeg[i] == 0) q.push(i);
+        }
+        while (!q.empty()) {
+            uint32_t cur = q.front(); q.pop();
+            order.push_back(cur);
+            for (uint32_t succ : passes[cur].successors) {
+                if (--inDeg[succ] == 0)
+                    q.push(succ);
+            }
+        }
+    } else {
+        // Same Kahn over units: an instance is sorted once, then expands
+        // to its passes in template order without looking at them.
+        std::vector<std::vector<uint32_t>> successors;
+        std::vector<uint32_t> inDeg;
+        BuildUnitEdges(successors, inDeg, false);
+        for (uint32_t i = 0; i < passes.size(); i++)
+            if (UnitOf(i) == i && inDeg[i] == 0) q.push(i);
+        while (!q.empty()) {
+            uint32_t cur = q.front(); q.pop();
+            if (passes[cur].group != UINT32_MAX) {
+                PassGroup& g = groups[passes[cur].group];
+                g.sortedPos = static_cast<uint32_t>(order.size());
+                for (uint32_t k = 0; k < g.passCount; k++) order.push_back(g.firstPass + k);
+            } else {
+                order.push_back(cur);
+            }
+            for (uint32_t succ : successors[cur]) {
+                if (--inDeg[succ] == 0)
+                    q.push(succ);
+            }
         }
     }
     assert(order.size() == passes.size() && "Cycle detected!");
-    printf("  Topological order: ");
+    Log("  Topological order: ");
     for (uint32_t i = 0; i < order.size(); i++) {
-        printf("%s%s", passes[order[i]].name.c_str(),
-               i + 1 < order.size() ? " -> " : "\n");
+        Log("%s%s", passes[order[i]].name.c_str(),
+            i + 1 < order.size() ? " -> " : "\n");
     }
     return order;
 }
@@ -116,51 +242,155 @@ std::vector<uint32_t> FrameGraph::TopoSort() {
 // == Cull dead passes ==========================================
 
 void FrameGraph::Cull(const std::vector<uint32_t>& sorted) {
+    for (auto& pass : passes) pass.alive = false;
+    for (auto& g : groups) g.alive = false;
     if (sorted.empty()) return;
-    passes[sorted.back()].alive = true;
+
+    auto MarkAlive = [&](uint32_t p) {
+        if (passes[p].group == UINT32_MAX) passes[p].alive = true;
+        else                               groups[passes[p].group].alive = true;
+    };
+    MarkAlive(sorted.back());
     for (int i = static_cast<int>(sorted.size()) - 1; i >= 0; i--) {
-        if (!passes[sorted[i]].alive) continue;
-        for (uint32_t dep : passes[sorted[i]].dependsOn)
-            passes[dep].alive = true;
+        uint32_t p = sorted[i];
+        if (passes[p].group != UINT32_MAX) {
+            // A live instance runs every pass that feeds one of its
+            // external outputs — decided once, by its template.
+            PassGroup& g = groups[passes[p].group];
+            i = static_cast<int>(g.sortedPos);
+            if (!g.alive) continue;
+            for (uint32_t k = 0; k < g.passCount; k++)
+                passes[g.firstPass + k].alive = g.plan->alive[k] != 0;
+            for (uint32_t dep : g.liveDeps) MarkAlive(dep);
+            continue;
+        }
+        if (!passes[p].alive) continue;
+        for (uint32_t dep : passes[p].dependsOn)
+            MarkAlive(dep);
     }
-    printf("  Culling result:   ");
+    Log("  Culling result:   ");
     for (uint32_t i = 0; i < passes.size(); i++) {
-        printf("%s=%s%s", passes[i].name.c_str(),
-               passes[i].alive ? "ALIVE" : "DEAD",
-               i + 1 < passes.size() ? ", " : "\n");
+        Log("%s=%s%s", passes[i].name.c_str(),
+            passes[i].alive ? "ALIVE" : "DEAD",
+            i + 1 < passes.size() ? ", " : "\n");
+    }
+}
+
+// == Scheduling units ==========================================
+// Every pass outside a subgraph instance is its own unit; an instance is
+// one unit named by its first pass. Unit edges come from dependsOn for
+// plain passes and from each instance's externalDeps, so an instance's
+// internal edges are never walked.
+
+uint32_t FrameGraph::UnitOf(uint32_t passIdx) const {
+    uint32_t g = passes[passIdx].group;
+    return g == UINT32_MAX ? passIdx : groups[g].firstPass;
+}
+
+void FrameGraph::BuildUnitEdges(std::vector<std::vector<uint32_t>>& successors,
+                                std::vector<uint32_t>& inDegree, bool aliveOnly) const {
+    successors.assign(passes.size(), {});
+    inDegree.assign(passes.size(), 0);
+    auto Live = [&](uint32_t unit) {
+        uint32_t g = passes[unit].group;
+        return !aliveOnly || (g == UINT32_MAX ? passes[unit].alive : groups[g].alive);
+    };
+    auto Edge = [&](uint32_t dep, uint32_t to) {
+        uint32_t from = UnitOf(dep);
+        if (!Live(from) || !Live(to)) return;
+        successors[from].push_back(to);
+        inDegree[to]++;
+    };
+    for (uint32_t i = 0; i < passes.size(); i++) {
+        uint32_t g = passes[i].group;
+        if (g == UINT32_MAX) {
+            for (uint32_t dep : passes[i].dependsOn) Edge(dep, i);
+            continue;
+        }
+        for (uint32_t dep : groups[g].externalDeps) Edge(dep, i);
+        i = groups[g].firstPass + groups[g].passCount - 1;
     }
 }
 
 // == Insert barriers ===========================================
 
-void FrameGraph::InsertBarriers(uint32_t passIdx) {
-    auto StateForUsage = [](bool isWrite, Format fmt) {
-        if (isWrite)
-            return (fmt == Format::D32F) ? ResourceState::DepthAttachment
-                                         : ResourceState::ColorAttachment;
-        return ResourceState::ShaderRead;
+// Walks a pass's accesses against `stateOf(resource)`, advancing it and
+// handing every transition to `emit`. Instance passes replay their
+// template's transient transitions and only resolve the resources
+// bound from outside.
+template <typename StateOf, typename EmitFn>
+void FrameGraph::ResolveTransitions(uint32_t passIdx, StateOf&& stateOf, EmitFn&& emit) const {
+    auto Transition = [&](uint32_t r, bool isWrite) {
+        ResourceState& state = stateOf(r);
+        ResourceState needed = StateForAccess(entries[r].desc, isWrite);
+        if (state != needed) {
+            emit(Barrier{ r, state, needed });
+            state = needed;
+        }
     };
 
-    for (auto& h : passes[passIdx].reads) {
-        ResourceState needed = ResourceState::ShaderRead;
-        if (entries[h.index].currentState != needed) {
-            printf("    barrier: resource[%u] %s -> %s\n",
-                   h.index,
-                   StateName(entries[h.index].currentState),
-                   StateName(needed));
-            entries[h.index].currentState = needed;
+    const RenderPass& pass = passes[passIdx];
+    if (pass.group != UINT32_MAX) {
+        const PassGroup&    g    = groups[pass.group];
+        const SubgraphPlan& plan = *g.plan;
+        uint32_t k = passIdx - g.firstPass;
+        for (uint32_t i = plan.stepFirst[k]; i < plan.stepFirst[k + 1]; i++) {
+            const SubgraphPlan::Step& step = plan.steps[i];
+            uint32_t r = g.view->handles[step.slot].index;
+            if (step.external) {
+                Transition(r, step.write);
+                continue;
+            }
+            stateOf(r) = step.after;
+            emit(Barrier{ r, step.before, step.after });
         }
+        return;
     }
-    for (auto& h : passes[passIdx].writes) {
-        ResourceState needed = StateForUsage(true, entries[h.index].desc.format);
-        if (entries[h.index].currentState != needed) {
-            printf("    barrier: resource[%u] %s -> %s\n",
-                   h.index,
-                   StateName(entries[h.index].currentState),
-                   StateName(needed));
-            entries[h.index].currentState = needed;
-        }
+    for (auto& h : pass.reads)  Transition(h.index, false);
+    for (auto& h : pass.writes) Transition(h.index, true);
+}
+
+uint32_t FrameGraph::InsertBarriers(uint32_t passIdx) {
+    uint32_t count = 0;
+    ResolveTransitions(passIdx,
+        [&](uint32_t r) -> ResourceState& { return entries[r].currentState; },
+        [&](const Barrier& b) {
+            Log("    barrier: resource[%u] %s -> %s\n",
+                b.resource, StateName(b.before), StateName(b.after));
+            count++;
+        });
+    return count;
+}
+
+BarrierSchedule FrameGraph::PlanBarriers(const CompiledPlan& plan) const {
+    std::vector<ResourceState> state(entries.size());
+    for (uint32_t i = 0; i < entries.size(); i++) state[i] = entries[i].currentState;
+
+    std::vector<std::vector<Barrier>> perPass(passes.size());
+    for (uint32_t idx : plan.sorted) {
+        if (!passes[idx].alive) continue;
+        ResolveTransitions(idx,
+            [&](uint32_t r) -> ResourceState& { return state[r]; },
+            [&](const Barrier& b) { perPass[idx].push_back(b); });
     }
+
+    BarrierSchedule schedule;
+    schedule.first.reserve(passes.size() + 1);
+    for (auto& list : perPass) {
+        schedule.first.push_back(static_cast<uint32_t>(schedule.barriers.size()));
+        schedule.barriers.insert(schedule.barriers.end(), list.begin(), list.end());
+    }
+    schedule.first.push_back(static_cast<uint32_t>(schedule.barriers.size()));
+    return schedule;
+}
+
+uint32_t FrameGraph::EmitBarriers(const BarrierSchedule& schedule, uint32_t passIdx) const {
+    for (uint32_t i = schedule.first[passIdx]; i < schedule.first[passIdx + 1]; i++) {
+        const Barrier& b = schedule.barriers[i];
+        Log("    barrier: resource[%u] %s -> %s\n",
+            b.resource, StateName(b.before), StateName(b.after));
+    }
+    return schedule.Count(passIdx);
 }
 
 // == Scan lifetimes (NEW v3) ===================================
@@ -175,6 +405,25 @@ std::vector<Lifetime> FrameGraph::ScanLifetimes(const std::vector<uint32_t>& sor
 
     for (uint32_t order = 0; order < sorted.size(); order++) {
         uint32_t passIdx = sorted[order];
+        if (passes[passIdx].group != UINT32_MAX) {
+            // An instance's slots: its template's lifetimes, shifted to
+            // where the instance landed in this order.
+            const PassGroup& g = groups[passes[passIdx].group];
+            assert(passIdx == g.firstPass
+                   && sorted[order + g.passCount - 1] == g.firstPass + g.passCount - 1
+                   && "Subgraph instances must stay contiguous in sorted order");
+            if (g.alive) {
+                for (uint32_t s = 0; s < g.plan->slotLife.size(); s++) {
+                    const Lifetime& local = g.plan->slotLife[s];
+                    if (local.firstUse == UINT32_MAX) continue;
+                    Lifetime& lt = life[g.view->handles[s].index];
+                    lt.firstUse = std::min(lt.firstUse, order + local.firstUse);
+                    lt.lastUse  = std::max(lt.lastUse,  order + local.lastUse);
+                }
+            }
+            order += g.passCount - 1;
+            continue;
+        }
         if (!passes[passIdx].alive) continue;
 
         for (auto& h : passes[passIdx].reads) {
@@ -186,80 +435,168 @@ std::vector<Lifetime> FrameGraph::ScanLifetimes(const std::vector<uint32_t>& sor
             life[h.index].lastUse  = std::max(life[h.index].lastUse,  order);
         }
     }
-    printf("  Lifetimes (in sorted pass order):\n");
+    Log("  Lifetimes (in sorted pass order):\n");
     for (uint32_t i = 0; i < life.size(); i++) {
         if (life[i].firstUse == UINT32_MAX) {
-            printf("    resource[%u] unused (dead)\n", i);
+            Log("    resource[%u] unused (dead)\n", i);
         } else {
-            printf("    resource[%u] alive [pass %u .. pass %u]\n",
-                   i, life[i].firstUse, life[i].lastUse);
+            Log("    resource[%u] alive [pass %u .. pass %u]\n",
+                i, life[i].firstUse, life[i].lastUse);
         }
     }
     return life;
 }
 
-// == Greedy free-list aliasing (NEW v3) ========================
+// == Free-list aliasing (NEW v3) ===============================
 
-std::vector<uint32_t> FrameGraph::AliasResources(const std::vector<Lifetime>& lifetimes) {
-    std::vector<PhysicalBlock> freeList;
+std::vector<uint32_t> FrameGraph::AliasResources(const std::vector<Lifetime>& lifetimes,
+                                                 std::vector<PhysicalBlock>& freeList,
+                                                 FreeBlockSearch* search) {
+    freeList.clear();
     std::vector<uint32_t> mapping(entries.size(), UINT32_MAX);
-    uint32_t totalWithout = 0;
+    uint64_t totalWithout = 0;
+
+    // What gets placed: one live transient, or one block a subgraph
+    // template already packed its transients into — placed whole, over
+    // the union of its occupants' lifetimes.
+    struct Item {
+        uint32_t  lead;                        // lowest resource index: tie-break
+        uint32_t  group = UINT32_MAX, block = 0;
+        Lifetime  life;
+        Footprint need;
+        ResourceType type;
+    };
+    std::vector<Item> items;
+    std::vector<bool> packed(entries.size(), false);
+    for (uint32_t g = 0; g < groups.size(); g++) {
+        if (!groups[g].alive) continue;
+        const auto& blocks = groups[g].plan->blocks;
+        if (groups[g].planDescs) {
+            // The template already sized these blocks; only where the
+            // instance landed in this order (any order, rescheduled too)
+            // is new, and one occupant's lifetime gives that.
+            const SubgraphPlan& plan = *groups[g].plan;
+            for (uint32_t blk = 0; blk < blocks.size(); blk++) {
+                const SubgraphPlan::BlockItem& cached = plan.blockItems[blk];
+                const auto& handles = groups[g].view->handles;
+                uint32_t first = blocks[blk][0];
+                uint32_t shift = lifetimes[handles[first].index].firstUse
+                               - plan.slotLife[first].firstUse;
+                uint32_t lead = UINT32_MAX;
+                for (uint32_t slot : blocks[blk]) {
+                    packed[handles[slot].index] = true;
+                    lead = std::min(lead, handles[slot].index);
+                }
+                items.push_back({ lead, g, blk,
+                                  { shift + cached.life.firstUse, shift + cached.life.lastUse },
+                                  cached.need, cached.type });
+                totalWithout += cached.unaliasedBytes;
+            }
+            continue;
+        }
+        for (uint32_t blk = 0; blk < blocks.size(); blk++) {
+            Item item{ UINT32_MAX, g, blk, {}, {}, ResourceType::Texture };
+            for (uint32_t slot : blocks[blk]) {
+                uint32_t r = groups[g].view->handles[slot].index;
+                const Lifetime& lt = lifetimes[r];
+                packed[r] = true;
+                if (lt.firstUse == UINT32_MAX) continue;
+                Footprint fp = ResourceFootprint(entries[r].desc);
+                totalWithout += fp.sizeBytes;
+                item.lead = std::min(item.lead, r);
+                item.life.firstUse = std::min(item.life.firstUse, lt.firstUse);
+                item.life.lastUse  = std::max(item.life.lastUse,  lt.lastUse);
+                item.need.sizeBytes = std::max(item.need.sizeBytes, fp.sizeBytes);
+                item.need.alignment = std::max(item.need.alignment, fp.alignment);
+                item.type = entries[r].desc.type;
+            }
+            if (item.lead != UINT32_MAX) items.push_back(item);
+        }
+    }
+    for (uint32_t r = 0; r < entries.size(); r++) {
+        if (packed[r] || !lifetimes[r].isTransient) continue;
+        if (lifetimes[r].firstUse == UINT32_MAX) continue;
+        Footprint fp = ResourceFootprint(entries[r].desc);
+        totalWithout += fp.sizeBytes;
+        items.push_back({ r, UINT32_MAX, 0, lifetimes[r], fp, entries[r].desc.type });
+    }
 
-    std::vector<uint32_t> indices(entries.size());
-    std::iota(indices.begin(), indices.end(), 0);
-    std::sort(indices.begin(), indices.end(), [&](uint32_t a, uint32_t b) {
-        return lifetimes[a].firstUse < lifetimes[b].firstUse;
+    // Ties keep declaration order, so a FreeBlockSearch agrees with the scan.
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.life.firstUse != b.life.firstUse ? a.life.firstUse < b.life.firstUse
+                                                  : a.lead < b.lead;
     });
 
-    printf("  Aliasing:\n");
-    for (uint32_t resIdx : indices) {
-        if (!lifetimes[resIdx].isTransient) continue;
-        if (lifetimes[resIdx].firstUse == UINT32_MAX) continue;
-
-        uint32_t needed = entries[resIdx].desc.width
-                        * entries[resIdx].desc.height
-                        * BytesPerPixel(entries[resIdx].desc.format);
-        totalWithout += needed;
-        bool reused = false;
-
-        for (uint32_t b = 0; b < freeList.size(); b++) {
-            if (freeList[b].availAfter < lifetimes[resIdx].firstUse
-                && freeList[b].sizeBytes >= needed) {
-                mapping[resIdx] = b;
-                freeList[b].availAfter = lifetimes[resIdx].lastUse;
-                reused = true;
-                printf("    resource[%u] -> reuse physical block %u  "
-                       "(%.1f MB, lifetime [%u..%u])\n",
-                       resIdx, b, needed / (1024.0f * 1024.0f),
-                       lifetimes[resIdx].firstUse,
-                       lifetimes[resIdx].lastUse);
-                break;
+    uint32_t passCount = 0;
+    for (auto& lt : lifetimes)
+        if (lt.firstUse != UINT32_MAX) passCount = std::max(passCount, lt.lastUse + 1);
+    if (search) search->Begin(freeList, heapTier, passCount);
+
+    auto MB = [](uint64_t bytes) { return bytes / (1024.0 * 1024.0); };
+
+    Log("  Aliasing:\n");
+    for (const Item& item : items) {
+        const Footprint& needed = item.need;
+        const char* kind = item.type == ResourceType::Buffer ? "buffer" : "texture";
+
+        uint32_t found = UINT32_MAX;
+        if (search) {
+            found = search->FindFirstFit(needed, item.type, item.life.firstUse);
+        } else {
+            for (uint32_t b = 0; b < freeList.size(); b++) {
+                if (freeList[b].availAfter < item.life.firstUse
+                    && freeList[b].sizeBytes >= needed.sizeBytes
+                    && freeList[b].alignment >= needed.alignment
+                    && CanShareHeap(heapTier, freeList[b].heapType, item.type)) {
+                    found = b;
+                    break;
+                }
             }
         }
 
-        if (!reused) {
-            mapping[resIdx] = static_cast<uint32_t>(freeList.size());
-            printf("    resource[%u] -> NEW physical block %u   "
-                   "(%.1f MB, lifetime [%u..%u])\n",
-                   resIdx, static_cast<uint32_t>(freeList.size()),
-                   needed / (1024.0f * 1024.0f),
-                   lifetimes[resIdx].firstUse,
-                   lifetimes[resIdx].lastUse);
-            freeList.push_back({ needed, lifetimes[resIdx].lastUse });
+        bool reuse = found != UINT32_MAX;
+        if (reuse) {
+            freeList[found].availAfter = item.life.lastUse;
+        } else {
+            found = static_cast<uint32_t>(freeList.size());
+            freeList.push_back({ needed.sizeBytes, needed.alignment,
+                                 item.life.lastUse, item.type });
+        }
+        if (search) search->Occupy(found, !reuse, item.life.lastUse);
+
+        if (item.group == UINT32_MAX) {
+            mapping[item.lead] = found;
+            Log(reuse ? "    resource[%u] -> reuse physical block %u  "
+                        "(%s, %.1f MB, lifetime [%u..%u])\n"
+                      : "    resource[%u] -> NEW physical block %u   "
+                        "(%s, %.1f MB, lifetime [%u..%u])\n",
+                item.lead, found, kind, MB(needed.sizeBytes),
+                item.life.firstUse, item.life.lastUse);
+            continue;
+        }
+        const PassGroup& g = groups[item.group];
+        uint32_t members = 0;
+        for (uint32_t slot : g.plan->blocks[item.block]) {
+            uint32_t r = g.view->handles[slot].index;
+            if (lifetimes[r].firstUse == UINT32_MAX) continue;
+            mapping[r] = found;
+            members++;
         }
+        Log("    subgraph block (%u resources from resource[%u]) -> %s physical block %u  "
+            "(%s, %.1f MB, lifetime [%u..%u])\n",
+            members, item.lead, reuse ? "reuse" : "NEW", found, kind,
+            MB(needed.sizeBytes), item.life.firstUse, item.life.lastUse);
     }
 
-    uint32_t totalWith = 0;
+    uint64_t totalWith = 0;
     for (auto& blk : freeList) totalWith += blk.sizeBytes;
-    printf("  Memory: %u physical blocks for %u virtual resources\n",
-           static_cast<uint32_t>(freeList.size()),
-           static_cast<uint32_t>(entries.size()));
-    printf("  Without aliasing: %.1f MB\n",
-           totalWithout / (1024.0f * 1024.0f));
-    printf("  With aliasing:    %.1f MB (saved %.1f MB, %.0f%%)\n",
-           totalWith / (1024.0f * 1024.0f),
-           (totalWithout - totalWith) / (1024.0f * 1024.0f),
-           totalWithout > 0 ? 100.0f * (totalWithout - totalWith) / totalWithout : 0.0f);
+    Log("  Memory: %u physical blocks for %u virtual resources\n",
+        static_cast<uint32_t>(freeList.size()),
+        static_cast<uint32_t>(entries.size()));
+    Log("  Without aliasing: %.1f MB\n", MB(totalWithout));
+    Log("  With aliasing:    %.1f MB (saved %.1f MB, %.0f%%)\n",
+        MB(totalWith), MB(totalWithout - totalWith),
+        totalWithout > 0 ? 100.0 * (totalWithout - totalWith) / totalWithout : 0.0);
 
     return mapping;
 }
@@ -1,24 +1,62 @@
 #pragma once
 // Frame Graph MVP v3 â€” Lifetimes & Aliasing
-// Adds: lifetime analysis, greedy free-list memory aliasing.
+// Adds: lifetime analysis, greedy free-list memory aliasing,
+//       buffer resources and alignment-aware 64-bit footprints.
 // Builds on v2 (dependencies, topo-sort, culling, barriers).
 //
 // Compile: g++ -std=c++17 -o example_v3 example_v3.cpp frame_graph_v3.cpp
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
+class FrameTracer;       // frame_graph_trace.h
+class TaskScheduler;     // frame_graph_tasks.h
+class AsyncPassTable;    // frame_graph_coro.h (C++20)
+class SubgraphTemplate;  // frame_graph_subgraph.h
+class FrameCapture;      // frame_graph_capture.h
+class GraphBuilder;      // frame_graph_builder.h
+class FrameGraphHook;    // below
+struct SubgraphBindings;
+struct SubgraphView;
+struct SubgraphInstance;
+struct SubgraphPlan;
+enum class MemorySchedule;   // frame_graph_budget.h
+
 // == Resource description (virtual until compile) ==============
 enum class Format { RGBA8, RGBA16F, R8, D32F };
 
+enum class ResourceType { Texture, Buffer };
+enum class BufferUsage  { Structured, Indirect, Constant };
+
 struct ResourceDesc {
     uint32_t width  = 0;
     uint32_t height = 0;
     Format   format = Format::RGBA8;
+
+    // Buffers leave width/height at zero and describe their bytes instead.
+    ResourceType type     = ResourceType::Texture;
+    uint64_t     byteSize = 0;
+    uint32_t     stride   = 0;    // element stride (structured buffers)
+    BufferUsage  usage    = BufferUsage::Structured;
+
+    // Dynamic-resolution textures: width/height are the maximum, which is
+    // what aliasing and descriptors see (frame_graph_pool.h).
+    bool dynamicResolution = false;
 };
 
+constexpr ResourceDesc BufferDesc(uint64_t byteSize, uint32_t stride,
+                                  BufferUsage usage = BufferUsage::Structured) {
+    ResourceDesc d;
+    d.type     = ResourceType::Buffer;
+    d.byteSize = byteSize;
+    d.stride   = stride;
+    d.usage    = usage;
+    return d;
+}
+
 struct ResourceHandle {
     uint32_t index = UINT32_MAX;
     bool IsValid() const { return index != UINT32_MAX; }
@@ -26,7 +64,8 @@ struct ResourceHandle {
 
 // == Resource state tracking ===================================
 enum class ResourceState { Undefined, ColorAttachment, DepthAttachment,
-                           ShaderRead, Present };
+                           ShaderRead, UnorderedAccess, IndirectArgument,
+                           Present };
 
 inline const char* StateName(ResourceState s) {
     switch (s) {
@@ -34,11 +73,26 @@ inline const char* StateName(ResourceState s) {
         case ResourceState::ColorAttachment: return "ColorAttachment";
         case ResourceState::DepthAttachment: return "DepthAttachment";
         case ResourceState::ShaderRead:      return "ShaderRead";
+        case ResourceState::UnorderedAccess: return "UnorderedAccess";
+        case ResourceState::IndirectArgument:return "IndirectArgument";
         case ResourceState::Present:         return "Present";
         default:                             return "?";
     }
 }
 
+// State a pass needs the resource in for a given access.
+constexpr ResourceState StateForAccess(const ResourceDesc& desc, bool isWrite) {
+    if (desc.type == ResourceType::Buffer) {
+        if (isWrite) return ResourceState::UnorderedAccess;
+        return desc.usage == BufferUsage::Indirect ? ResourceState::IndirectArgument
+                                                   : ResourceState::ShaderRead;
+    }
+    if (isWrite)
+        return (desc.format == Format::D32F) ? ResourceState::DepthAttachment
+                                             : ResourceState::ColorAttachment;
+    return ResourceState::ShaderRead;
+}
+
 struct ResourceVersion {
     uint32_t writerPass = UINT32_MAX;
     std::vector<uint32_t> readerPasses;
@@ -52,14 +106,29 @@ struct ResourceEntry {
     bool imported = false;   // imported resources are not owned by the graph
 };
 
+// == Placement rules ===========================================
+// Placed resources start on 64 KB boundaries (D3D12 default, and the
+// common Vulkan bufferImageGranularity worst case).
+constexpr uint64_t kPlacementAlignment = 64 * 1024;
+
+// Resource heap tier: Tier1 keeps buffers and render-target textures in
+// separate heaps, Tier2 lets them alias the same memory.
+enum class HeapTier { Tier1, Tier2 };
+
+constexpr bool CanShareHeap(HeapTier tier, ResourceType a, ResourceType b) {
+    return tier == HeapTier::Tier2 || a == b;
+}
+
 // == Physical memory block (NEW v3) ============================
 struct PhysicalBlock {
-    uint32_t sizeBytes   = 0;
-    uint32_t availAfter  = 0;  // pass index after which this block is free
+    uint64_t     sizeBytes  = 0;
+    uint64_t     alignment  = kPlacementAlignment;
+    uint32_t     availAfter = 0;  // pass index after which this block is free
+    ResourceType heapType   = ResourceType::Texture;  // type of first occupant
 };
 
 // == Bytes-per-pixel helper (NEW v3) ===========================
-inline uint32_t BytesPerPixel(Format fmt) {
+constexpr uint32_t BytesPerPixel(Format fmt) {
     switch (fmt) {
         case Format::R8:      return 1;
         case Format::RGBA8:   return 4;
@@ -69,6 +138,31 @@ inline uint32_t BytesPerPixel(Format fmt) {
     }
 }
 
+// == Footprint: size + alignment the allocator must reserve ====
+struct Footprint {
+    uint64_t sizeBytes = 0;
+    uint64_t alignment = kPlacementAlignment;
+};
+
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Textures use 64 KB standard-swizzle tiles, so each dimension is padded
+// to a whole tile — a 1920x1080 RGBA8 target really costs 1920x1152.
+constexpr Footprint ResourceFootprint(const ResourceDesc& desc) {
+    if (desc.type == ResourceType::Buffer)
+        return { AlignUp(desc.byteSize, kPlacementAlignment), kPlacementAlignment };
+
+    uint32_t bpp   = BytesPerPixel(desc.format);
+    uint32_t tileW = 128, tileH = 128;                 // 4 bytes/texel
+    if      (bpp == 1) { tileW = 256; tileH = 256; }
+    else if (bpp == 8) { tileW = 128; tileH = 64;  }
+    uint64_t w = AlignUp(desc.width,  tileW);
+    uint64_t h = AlignUp(desc.height, tileH);
+    return { AlignUp(w * h * bpp, kPlacementAlignment), kPlacementAlignment };
+}
+
 // == Lifetime info per resource (NEW v3) =======================
 struct Lifetime {
     uint32_t firstUse = UINT32_MAX;
@@ -77,6 +171,10 @@ struct Lifetime {
 };
 
 // == Render pass ===============================================
+// Gpu passes record commands in sorted order; Cpu passes are plain jobs
+// a TaskScheduler may run on any core once their producers finish.
+enum class PassKind { Gpu, Cpu };
+
 struct RenderPass {
     std::string name;
     std::function<void()>             Setup;
@@ -88,6 +186,51 @@ struct RenderPass {
     std::vector<uint32_t> successors;
     uint32_t inDegree = 0;
     bool     alive    = false;
+    PassKind kind     = PassKind::Gpu;
+    bool     depsUnique = false;   // dependsOn already deduplicated (subgraph instances)
+    uint32_t group      = UINT32_MAX;   // subgraph instance this pass belongs to
+};
+
+// == Resolved barriers =========================================
+// A pass's transitions, resolved ahead of execution in sorted order.
+// Executors that record out of order (Cpu jobs, suspended coroutines)
+// emit each pass's slice when it records, so the barriers always match
+// the order command lists are submitted in.
+struct Barrier {
+    uint32_t      resource = 0;
+    ResourceState before   = ResourceState::Undefined;
+    ResourceState after    = ResourceState::Undefined;
+};
+
+struct BarrierSchedule {
+    std::vector<Barrier>  barriers;   // grouped by pass
+    std::vector<uint32_t> first;      // pass i owns [first[i], first[i + 1])
+
+    uint32_t Count(uint32_t passIdx) const { return first[passIdx + 1] - first[passIdx]; }
+};
+
+// == Free-block search hook ====================================
+// AliasResources() walks the free list for every resource — O(R x B).
+// A FreeBlockSearch answers the same first-fit query from an index of
+// its own; frame_graph_bitset.h has one for very large graphs.
+class FreeBlockSearch {
+public:
+    virtual ~FreeBlockSearch() = default;
+
+    // New aliasing run: `blocks` grows as it goes, every lastUse < passCount.
+    virtual void     Begin(const std::vector<PhysicalBlock>& blocks, HeapTier tier,
+                           uint32_t passCount) = 0;
+    // Lowest-index block free before `firstUse` that fits, or UINT32_MAX.
+    // Asked in non-decreasing firstUse order.
+    virtual uint32_t FindFirstFit(const Footprint& need, ResourceType type,
+                                  uint32_t firstUse) = 0;
+    // `block` holds data until `lastUse`; `isNew` if just pushed.
+    virtual void     Occupy(uint32_t block, bool isNew, uint32_t lastUse) = 0;
+};
+
+// == Compile options ===========================================
+struct CompileOptions {
+    FreeBlockSearch* blockSearch = nullptr;   // null: linear free-list scan
 };
 
 // == Frame graph (v3: full MVP) ================================
@@ -100,35 +243,179 @@ public:
     void Read(uint32_t passIdx, ResourceHandle h);
     void Write(uint32_t passIdx, ResourceHandle h);
 
+    // Tier2 (default) lets buffers and textures alias the same blocks.
+    void     SetHeapTier(HeapTier tier) { heapTier = tier; }
+    HeapTier Tier() const { return heapTier; }
+
+    // Opt-in Chrome trace capture of compile phases and executed passes.
+    void SetTracer(FrameTracer* t) { tracer = t; }
+
+    // Opt-in recording of every declaration call (and pass timings) for
+    // offline replay; see frame_graph_capture.h.
+    void SetCapture(FrameCapture* c) { capture = c; }
+
+    // Console trace of every compile/execute step (on by default).
+    void SetVerbose(bool v) { verbose = v; }
+
+    // Dynamic resolution: set per frame, read by passes at execute time
+    // (ActiveExtent() in frame_graph_pool.h). Compile() never looks at
+    // it, so a new scale changes no plan.
+    void  SetResolutionScale(float scale) { resolutionScale = scale; }
+    float ResolutionScale() const { return resolutionScale; }
+
+    // Opt-in modules that keep state across frames; run in attach order
+    // after every finished plan and at the end of every frame.
+    void AddHook(FrameGraphHook* hook) { hooks.push_back(hook); }
+
+    uint64_t FrameIndex() const { return frameIndex; }
+
+    // Read-only view for tools (simulator, capture) — valid until Execute().
+    const std::vector<RenderPass>&    Passes()  const { return passes; }
+    const std::vector<ResourceEntry>& Entries() const { return entries; }
+
     template <typename SetupFn, typename ExecFn>
-    void AddPass(const std::string& name, SetupFn&& setup, ExecFn&& exec) {
+    void AddPass(const std::string& name, SetupFn&& setup, ExecFn&& exec,
+                 PassKind kind = PassKind::Gpu) {
         passes.push_back({ name, std::forward<SetupFn>(setup),
                                    std::forward<ExecFn>(exec) });
+        passes.back().kind = kind;
+        if (capture) CaptureAddPass(static_cast<uint32_t>(passes.size() - 1));
         passes.back().Setup();
     }
 
+    // Splices a compiled subgraph template into the graph for one view:
+    // no setup lambdas run and no edges are rediscovered. Defined in
+    // frame_graph_subgraph.cpp.
+    SubgraphInstance Instantiate(const SubgraphTemplate& tmpl,
+                                 const SubgraphBindings& bindings);
+
+    // Makes the last `passCount` passes (already in a valid local order)
+    // and the `transientCount` resources created just before them one
+    // subgraph instance, as Instantiate() does. Lets a replayed capture
+    // schedule instances exactly like the live frame. Defined in
+    // frame_graph_subgraph.cpp.
+    bool GroupPasses(uint32_t passCount, uint32_t transientCount);
+
+    // Appends a builder filled on another thread (moves its passes out).
+    // Merge builders in a fixed order for a deterministic graph. Defined
+    // in frame_graph_builder.cpp.
+    void Merge(GraphBuilder& builder);
+
     // == v3: compile â€” builds the execution plan + allocates memory ==
     struct CompiledPlan {
         std::vector<uint32_t> sorted;
         std::vector<uint32_t> mapping;   // mapping[virtualIdx] → physicalBlock
+        std::vector<PhysicalBlock> blocks;   // sizes of the physical blocks
+        std::vector<Lifetime> lifetimes;     // per virtual resource, sorted order
+        uint64_t    memoryBytes = 0;         // aliased total: sum of blocks
+        bool        overBudget  = false;     // CompileWithinBudget() found no fit;
+        std::string diagnostic;              // peak pass + live set, not committed
     };
 
-    CompiledPlan Compile();
+    CompiledPlan Compile(const CompileOptions& options = {});
+
+    // Compile() under a hard ceiling on aliased transient memory: tries
+    // memory-aware pass orders when the first plan is over it. Defined in
+    // frame_graph_budget.cpp.
+    CompiledPlan CompileWithinBudget(uint64_t memoryBudget,
+                                     const CompileOptions& options = {});
 
     // == v3: execute â€” runs the compiled plan =================
     void Execute(const CompiledPlan& plan);
 
+    // Runs Cpu passes on the scheduler's workers as soon as their
+    // dependencies finish; Gpu passes still record in sorted order on
+    // the calling thread. Defined in frame_graph_tasks.cpp.
+    void Execute(const CompiledPlan& plan, TaskScheduler& scheduler);
+
+    // Passes with a coroutine body in `async` may suspend on uploads,
+    // fences or other passes; everything whose dependencies are met keeps
+    // recording meanwhile. Defined in frame_graph_coro.cpp (C++20).
+    void Execute(const CompiledPlan& plan, AsyncPassTable& async);
+
     // convenience: compile + execute in one call
     void Execute();
 
+    // The transitions Execute(plan) will emit, resolved in sorted order
+    // from each resource's current state. Leaves the graph untouched.
+    BarrierSchedule PlanBarriers(const CompiledPlan& plan) const;
+
 private:
     std::vector<RenderPass>    passes;
     std::vector<ResourceEntry> entries;
+    HeapTier heapTier = HeapTier::Tier2;
+    FrameTracer* tracer = nullptr;
+    FrameCapture* capture = nullptr;
+    bool verbose = true;
+    float resolutionScale = 1.0f;
+    std::vector<FrameGraphHook*> hooks;
+    std::vector<std::shared_ptr<const SubgraphView>> subgraphViews;   // this frame's instances
+
+    // A subgraph instance: contiguous passes in template order that
+    // Compile() sorts, culls, scans and aliases as one unit, from the
+    // template's SubgraphPlan instead of pass by pass.
+    struct PassGroup {
+        uint32_t firstPass = 0;
+        uint32_t passCount = 0;
+        uint32_t sortedPos = 0;       // position of firstPass, set by TopoSort()
+        bool     alive     = false;   // set by Cull()
+        std::shared_ptr<const SubgraphPlan> plan;
+        const SubgraphView*   view = nullptr;   // slot -> handle
+        bool planDescs = true;   // transients use the descs the plan packed
+        std::vector<uint32_t> externalDeps;     // outside passes any of its passes read
+        std::vector<uint32_t> liveDeps;         // ... that its live passes read
+    };
+    std::vector<PassGroup> groups;   // this frame's instances
+    uint64_t frameIndex = 0;
+
+    void Log(const char* fmt, ...) const;   // printf, only when verbose
 
     void BuildEdges();
     std::vector<uint32_t> TopoSort();
     void Cull(const std::vector<uint32_t>& sorted);
-    void InsertBarriers(uint32_t passIdx);
+    uint32_t UnitOf(uint32_t passIdx) const;   // first pass of its group, or itself
+    void BuildUnitEdges(std::vector<std::vector<uint32_t>>& successors,
+                        std::vector<uint32_t>& inDegree, bool aliveOnly) const;
+    template <typename StateOf, typename EmitFn>
+    void ResolveTransitions(uint32_t passIdx, StateOf&& stateOf, EmitFn&& emit) const;
+    uint32_t InsertBarriers(uint32_t passIdx);   // returns barrier count
+    uint32_t EmitBarriers(const BarrierSchedule& schedule, uint32_t passIdx) const;
+    void ExecutePassTraced(uint32_t passIdx,    // tracer and/or capture timings
+                           const BarrierSchedule* schedule = nullptr);
+    void RecordPassTime(uint32_t passIdx, uint64_t beginNs, uint64_t endNs,
+                        uint32_t barriers);      // one recording slice of a pass
+    void CaptureAddPass(uint32_t passIdx);
+    void CaptureResolvedPass(uint32_t passIdx);   // AddPass + its reads/writes
+    void CaptureGroup(uint32_t passCount, uint32_t transientCount);
+    void CaptureCompile(const CompileOptions& options, bool budgeted, uint64_t memoryBudget);
+    void AddGroup(uint32_t firstPass, uint32_t passCount,   // frame_graph_subgraph.cpp
+                  std::shared_ptr<const SubgraphPlan> plan, const SubgraphView* view,
+                  bool planDescs);
     std::vector<Lifetime> ScanLifetimes(const std::vector<uint32_t>& sorted);  // NEW v3
-    std::vector<uint32_t> AliasResources(const std::vector<Lifetime>& lifetimes); // NEW v3
+    std::vector<uint32_t> AliasResources(const std::vector<Lifetime>& lifetimes,
+                                         std::vector<PhysicalBlock>& blocks,
+                                         FreeBlockSearch* search);            // NEW v3
+    void EndFrame();   // drop this frame's passes, retire old frames
+    CompiledPlan BuildPlan(const CompileOptions& options);   // steps [1]-[5]
+    void FinishPlan(CompiledPlan& plan);                      // after any rescheduling
+    void FitToBudget(CompiledPlan& plan, uint64_t budget,    // frame_graph_budget.cpp
+                     const CompileOptions& options);
+    std::vector<uint32_t> ScheduleForMemory(MemorySchedule heuristic) const;
+    std::string BudgetDiagnostic(const CompiledPlan& plan, uint64_t budget) const;
+};
+
+// == Frame hooks ===============================================
+// Frames the GPU may still be reading; anything a hook recycles (heap
+// blocks, descriptor slots, upload memory) waits this many frames first.
+constexpr uint32_t kFramesInFlight = 2;
+
+class FrameGraphHook {
+public:
+    virtual ~FrameGraphHook() = default;
+    // A finished plan, after any rescheduling. Over-budget plans come
+    // here too, flagged, so a hook can refuse to commit anything for them.
+    virtual void OnCompiled(const FrameGraph& fg, const FrameGraph::CompiledPlan& plan) = 0;
+    // The frame's last pass has run. FrameIndex() and Passes() still
+    // describe the frame that ended.
+    virtual void OnEndFrame(const FrameGraph& fg) = 0;
 };
@@ -0,0 +1,137 @@
+// Frame Graph -- replay a captured frame for offline profiling
+// Rebuilds each captured frame, then compiles it with the settings it
+// was captured with (heap tier, block search, budget, resolution scale)
+// and simulates it, in a loop.
+//
+//   replay_tool capture.fgcap [iterations] [frame]
+//
+// Compile: g++ -std=c++17 -O2 -o replay_tool replay_tool.cpp frame_graph_v3.cpp frame_graph_sim.cpp frame_graph_capture.cpp frame_graph_subgraph.cpp frame_graph_budget.cpp frame_graph_bitset.cpp
+#include "frame_graph_bitset.h"
+#include "frame_graph_budget.h"
+#include "frame_graph_capture.h"
+#include "frame_graph_sim.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using Clock = std::chrono::steady_clock;
+
+static double Us(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+// Digits only: strtoul alone accepts a sign (and wraps "-1") and
+// stops quietly at trailing junk.
+static bool ParseUint(const char* text, uint32_t& out) {
+    if (!isdigit(static_cast<unsigned char>(text[0]))) return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long v = strtoul(text, &end, 10);
+    if (errno != 0 || *end != '\0' || v > UINT32_MAX) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+}
+
+static FrameGraph::CompiledPlan CompileAsCaptured(FrameGraph& fg, const CapturedCompile& settings,
+                                                  BitsetBlockSearch& search) {
+    CompileOptions options;
+    if (settings.indexedSearch) options.blockSearch = &search;
+    return settings.budgeted ? fg.CompileWithinBudget(settings.memoryBudget, options)
+                             : fg.Compile(options);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s capture.fgcap [iterations] [frame]\n", argv[0]);
+        return 2;
+    }
+    uint32_t iterations = 100;
+    if (argc > 2 && (!ParseUint(argv[2], iterations) || iterations == 0)) {
+        fprintf(stderr, "iterations must be a positive integer, got '%s'\n", argv[2]);
+        return 2;
+    }
+    uint32_t onlyFrame = UINT32_MAX;
+    if (argc > 3 && !ParseUint(argv[3], onlyFrame)) {
+        fprintf(stderr, "frame must be a frame index, got '%s'\n", argv[3]);
+        return 2;
+    }
+
+    FrameCapture capture;
+    if (!capture.Load(argv[1])) {
+        fprintf(stderr, "cannot load capture '%s'\n", argv[1]);
+        return 1;
+    }
+    uint32_t first = 0, last = capture.FrameCount();
+    if (onlyFrame != UINT32_MAX) {
+        if (onlyFrame >= capture.FrameCount()) {
+            fprintf(stderr, "frame %u out of range: '%s' has %u frames\n",
+                    onlyFrame, argv[1], capture.FrameCount());
+            return 1;
+        }
+        first = onlyFrame;
+        last  = onlyFrame + 1;
+    }
+    printf("=== Replay: %s (%u frames, %zu bytes) ===\n\n",
+           argv[1], capture.FrameCount(), capture.Bytes());
+
+    for (uint32_t frame = first; frame < last; frame++) {
+        double rebuildUs = 0, compileUs = 0, simUs = 0;
+        double bestCompileUs = 1e30;
+        SimReport report;
+        CapturedCompile settings;
+        BitsetBlockSearch search;
+        uint32_t passes = 0, resources = 0;
+        uint64_t memory = 0;
+        bool overBudget = false;
+
+        for (uint32_t i = 0; i < iterations; i++) {
+            FrameGraph fg;
+            fg.SetVerbose(false);
+            SimCosts costs;
+
+            auto t0 = Clock::now();
+            if (!capture.Replay(frame, fg, &costs, &settings)) {
+                fprintf(stderr, "frame %u: malformed capture\n", frame);
+                return 1;
+            }
+            auto t1 = Clock::now();
+            auto plan = CompileAsCaptured(fg, settings, search);
+            auto t2 = Clock::now();
+            report = SimulateTimeline(fg, plan, costs);
+            auto t3 = Clock::now();
+
+            rebuildUs += Us(t0, t1);
+            compileUs += Us(t1, t2);
+            simUs     += Us(t2, t3);
+            bestCompileUs = std::min(bestCompileUs, Us(t1, t2));
+            passes    = static_cast<uint32_t>(fg.Passes().size());
+            resources = static_cast<uint32_t>(fg.Entries().size());
+            memory    = plan.memoryBytes;
+            overBudget = plan.overBudget;
+        }
+
+        printf("  frame %u: %u passes, %u resources, %.1f MB aliased%s\n",
+               frame, passes, resources, memory / (1024.0 * 1024.0),
+               overBudget ? " (over budget)" : "");
+        if (settings.recorded) {
+            printf("    compiled as captured: heap tier %d, %s search, ",
+                   settings.tier == HeapTier::Tier1 ? 1 : 2,
+                   settings.indexedSearch ? "indexed" : "linear");
+            if (settings.budgeted) printf("budget %.1f MB, ", settings.memoryBudget / (1024.0 * 1024.0));
+            else                   printf("no budget, ");
+            printf("resolution scale %.2f\n", settings.resolutionScale);
+        } else {
+            printf("    no compile settings captured: defaults\n");
+        }
+        printf("    rebuild %.1f us, Compile %.1f us (best %.1f), simulate %.1f us"
+               "  [avg of %u]\n",
+               rebuildUs / iterations, compileUs / iterations, bestCompileUs,
+               simUs / iterations, iterations);
+        printf("    simulated frame %.1f us, %u barriers, idle %.1f us\n",
+               report.frameUs, report.barrierCount, report.idleUs);
+    }
+    return 0;
+}